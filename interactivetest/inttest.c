@@ -14,112 +14,6 @@
 #endif
 //---------------------------------------------------------------------
 
-/**
- *
- * @struct tCODES_DESC
- * @brief  Represents the MEP code string description for each code and custom codes.
- */
-typedef struct
-{
-    uint16_t code;
-    char desc[30];
-}
-tCODES_DESC;
-//---------------------------------------------------------------------
-
-tCODES_DESC codes_names[] =
-{
-    { .code = MEP_STATUS                      ,  .desc = "STATUS"                     },
-    { .code = MEP_HARDWARE_MODEL              ,  .desc = "HARDWARE_MODEL"             },
-    { .code = MEP_FIRMWARE_MODEL              ,  .desc = "FIRMWARE_MODEL"             },
-    { .code = MEP_FIRMWARE_VERSION            ,  .desc = "FIRMWARE_VERSION"           },
-    { .code = MEP_FIRMWARE_RELEASE            ,  .desc = "FIRMWARE_RELEASE"           },
-    { .code = MEP_FIRMWARE_DEVICE_TYPE        ,  .desc = "FIRMWARE_DEVICE_TYPE"       },
-    { .code = MEP_DEVICE_ID                   ,  .desc = "DEVICE_ID"                  },
-    { .code = MEP_DEVICE_DESCRIPTION          ,  .desc = "DEVICE_DESCRIPTION"         },
-    { .code = MEP_RESET                       ,  .desc = "RESET"                      },
-    { .code = MEP_VIS_EXTENSIBLE              ,  .desc = "VIS_EXTENSIBLE"             },
-    { .code = MEP_TEMP_1                      ,  .desc = "TEMP_1"                     },
-    { .code = MEP_TEMP_2                      ,  .desc = "TEMP_2"                     },
-    { .code = MEP_TEMP_3                      ,  .desc = "TEMP_3"                     },
-    { .code = MEP_TEMP_4                      ,  .desc = "TEMP_4"                     },
-    { .code = MEP_TEMP_5                      ,  .desc = "TEMP_5"                     },
-    { .code = MEP_TEMP_6                      ,  .desc = "TEMP_6"                     },
-    { .code = MEP_TEMP_7                      ,  .desc = "TEMP_7"                     },
-    { .code = MEP_TEMP_8                      ,  .desc = "TEMP_8"                     },
-    { .code = MEP_HUMIDITY_1                  ,  .desc = "HUMIDITY_1"                 },
-    { .code = MEP_HUMIDITY_2                  ,  .desc = "HUMIDITY_2"                 },
-    { .code = MEP_HUMIDITY_3                  ,  .desc = "HUMIDITY_3"                 },
-    { .code = MEP_HUMIDITY_4                  ,  .desc = "HUMIDITY_4"                 },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_1  ,  .desc = "ENVIRONMENTAL_BRIGHTNESS_1" },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_2  ,  .desc = "ENVIRONMENTAL_BRIGHTNESS_2" },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_3  ,  .desc = "ENVIRONMENTAL_BRIGHTNESS_3" },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_4  ,  .desc = "ENVIRONMENTAL_BRIGHTNESS_4" },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_5  ,  .desc = "ENVIRONMENTAL_BRIGHTNESS_5" },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_6  ,  .desc = "ENVIRONMENTAL_BRIGHTNESS_6" },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_7  ,  .desc = "ENVIRONMENTAL_BRIGHTNESS_7" },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_8  ,  .desc = "ENVIRONMENTAL_BRIGHTNESS_8" },
-    { .code = MEP_LED_BRIGHTNESS_OUTPUT       ,  .desc = "LED_BRIGHTNESS_OUTPUT"      },
-    { .code = MEP_LED_OUTPUT_PERCENTAGE       ,  .desc = "LED_OUTPUT_PERCENTAGE"      },
-    { .code = MEP_DEVICE_RESTARTED            ,  .desc = "DEVICE_RESTARTED"           },
-    { .code = MEP_DOORS_OPEN                  ,  .desc = "DOORS_OPEN"                 },
-    { .code = MEP_INTERNAL_ERROR_CODE         ,  .desc = "INTERNAL_ERROR_CODE"        },
-    { .code = MEP_POWER_SAVING_STATUS         ,  .desc = "POWER_SAVING_STATUS"        },
-    { .code = MEP_BATTERY_LEVEL               ,  .desc = "BATTERY_LEVEL"              },
-    { .code = MEP_FANS_ACTIVE                 ,  .desc = "FANS_ACTIVE"                },
-    { .code = MEP_HEATING_ACTIVE              ,  .desc = "HEATING_ACTIVE"             },
-    { .code = MEP_SIREN_ACTIVE                ,  .desc = "SIREN_ACTIVE"               },
-    { .code = MEP_BROKEN_FANS_NUMBER          ,  .desc = "BROKEN_FANS_NUMBER"         },
-    { .code = MEP_BROKEN_LEDS_NUMBER          ,  .desc = "BROKEN_LEDS_NUMBER"         },
-    { .code = MEP_BROKEN_BACKLIGHTS_NUMBER    ,  .desc = "BROKEN_BACKLIGHTS_NUMBER"   },
-    { .code = MEP_NUM_BROKEN_LED_BOARDS       ,  .desc = "NUM_BROKEN_LED_BOARDS"      },
-    { .code = MEP_CLOCK                       ,  .desc = "CLOCK"                      },
-    { .code = MEP_COLORS_CALIBRATION          ,  .desc = "COLORS_CALIBRATION"         },
-    { .code = MEP_REMEMBER_LAST_PUBLICATION   ,  .desc = "REMEMBER_LAST_PUBLICATION"  },
-    { .code = MEP_BRIGHTNESS_1                ,  .desc = "BRIGHTNESS_1"               },
-    { .code = MEP_BRIGHTNESS_2                ,  .desc = "BRIGHTNESS_2"               },
-    { .code = MEP_BRIGHTNESS_3                ,  .desc = "BRIGHTNESS_3"               },
-    { .code = MEP_BRIGHTNESS_4                ,  .desc = "BRIGHTNESS_4"               },
-    { .code = MEP_TRAFFIC_LIGHT_STATUS_1      ,  .desc = "TRAFFIC_LIGHT_STATUS_1"     },
-    { .code = MEP_TRAFFIC_LIGHT_STATUS_2      ,  .desc = "TRAFFIC_LIGHT_STATUS_2"     },
-    { .code = MEP_TRAFFIC_LIGHT_STATUS_3      ,  .desc = "TRAFFIC_LIGHT_STATUS_3"     },
-    { .code = MEP_TRAFFIC_LIGHT_STATUS_4      ,  .desc = "TRAFFIC_LIGHT_STATUS_4"     },
-    { .code = MEP_CUSTOM_SET_TEXT             ,  .desc = "SET_TEXT"                   },
-    { .code = MEP_CUSTOM_SET_PICTO            ,  .desc = "SET_PICTO"                  },
-    { .code = MEP_CUSTOM_SET_DEVID            ,  .desc = "SET_DEVID"                  },
-    { .code = MEP_CUSTOM_SET_TRAFFIC          ,  .desc = "SET_TRAFFIC"                },
-    { .code = MEP_CUSTOM_SET_DEVDESC          ,  .desc = "SET_DEVDESC"                },
-    { .code = MEP_CUSTOM_SET_BRIGHTNESS       ,  .desc = "SET_BRIGHTNESS"             },
-    { .code = MEP_CUSTOM_DELETE_CODE          ,  .desc = "DELETE_CODE"                },
-    { .code = MEP_CUSTOM_CLEAR_PUB            ,  .desc = "CLEAR_PUB"                  },
-    { .code = MEP_CUSTOM_STATUS_INFO_DATA     ,  .desc = "STATUS_INFO_DATA"           },
-    { .code = MEP_CUSTOM_DEVICE_INFO_DATA     ,  .desc = "DEVICE_INFO_DATA"           },
-    { .code = MEP_CUSTOM_TRAFFIC_INFO_DATA    ,  .desc = "TRAFFIC_INFO_DATA"          },
-    { .code = MEP_CUSTOM_HUMIDITY_INFO_DATA   ,  .desc = "HUMIDITY_INFO_DATA"         },
-    { .code = MEP_CUSTOM_BRIGHTNESS_INFO_DATA ,  .desc = "BRIGHTNESS_INFO_DATA"       },
-    { .code = MEP_CUSTOM_DIAGNOSTIC_INFO_DATA ,  .desc = "DIAGNOSTIC_INFO_DATA"       },
-    { .code = MEP_CUSTOM_TEMPERATURE_INFO_DATA,  .desc = "TEMPERATURE_INFO_DATA"      },
-    { .code = MEP_CUSTOM_EBRIGHTNESS_INFO_DATA,  .desc = "EBRIGHTNESS_INFO_DATA"      },
-};
-//--------------------------------------------------------------------
-
-/** @brief Return the code description of a valid MEP code.
- *
- * @param  code The MEP code to get the string description.
- * @return const string with code description.
- */
-const char * find_code_desc(uint16_t code)
-{
-    uint16_t size = sizeof(codes_names)/sizeof(tCODES_DESC);
-
-    for (uint16_t i = 0; i < size; i++)
-         if (code == codes_names[i].code)
-             return codes_names[i].desc;
-
-    return NULL;
-}
-//---------------------------------------------------------------------
-
 /** @brief Prepare and build simple or multitext message.
  *
  * @param  str Is the message introduced by the user and converted to a simple message.
@@ -168,7 +62,7 @@ void PrintResponse(tAESYS_MEP_RESPONSE *response)
     if (response)
     {
         tAESYS_MEP_RESPONSE_DATA *current = response->data;
-        const char *desc = find_code_desc(response->type);
+        const char *desc = AesysMepGetCodeName(response->type);
 
         printf("Response. Transaction ID: 0x%.2X Response Type: ",response->tran);
 
@@ -182,7 +76,7 @@ void PrintResponse(tAESYS_MEP_RESPONSE *response)
 
         while (current != NULL)
         {
-            desc = find_code_desc(current->code);
+            desc = AesysMepGetCodeName(current->code);
             if (desc != NULL)
                 printf("\nMEP CODE: %s\n",desc);
             else
@@ -281,8 +175,12 @@ void PrintResponse(tAESYS_MEP_RESPONSE *response)
 void SendAndParseResponse(int socket, uint8_t type, tAESYS_MEP_BUFFER *msg_buffer)
 {
     int bytes;
+    char ret = 0;
+    uint16_t offset = 0, received = 0;
+    tAESYS_MEP_PPTP_VIEW view;
     tAESYS_MEP_RESPONSE *response = NULL;
     uint8_t rx_buffer[K_MEP_MAX_FRAME_SIZE+2];
+    static tAESYS_MEP_UPTB_DEFRAMER deframer;
 
     if (msg_buffer != NULL)
     {
@@ -290,11 +188,32 @@ void SendAndParseResponse(int socket, uint8_t type, tAESYS_MEP_BUFFER *msg_buffe
             printf("Error sending command to device\n");
         else
         {
-            bytes = recv(socket, (char *) rx_buffer, sizeof (rx_buffer), 0);
+            // The response can arrive in several chunks. The UoPTB chunks are
+            // decoded by the deframer, the PPTP chunks are kept until the
+            // frame is complete.
+            AesysMepInitUPTBDeframer(&deframer);
+            do
+            {
+                bytes  = recv(socket, (char *) &rx_buffer[received], sizeof (rx_buffer)-received, 0);
+                offset = 0;
+                if (bytes > 0 && type)
+                    ret = AesysMepReadNextUPTBFrame(&deframer,rx_buffer,bytes,&offset);
+                else if (bytes > 0)
+                {
+                    received += bytes;
+                    ret = AesysMepReadNextPPTPFrame(rx_buffer,received,&offset,&view);
+                }
+            }
+            while (bytes > 0 && ret == 0 && received < sizeof (rx_buffer));
 
             if (bytes > 0)
             {
-                response = AesysMepParseResponse(rx_buffer,bytes,type);
+                if (ret != 1)
+                    errno = ENOEXEC;
+                else if (type)
+                    response = AesysMepParseDecodedUPTBFrame(deframer.frame);
+                else
+                    response = AesysMepParseResponse(rx_buffer,offset,type);
                 if (response != NULL)
                     PrintResponse(response);
                 else
@@ -1,4 +1,8 @@
 #include "aesys_mep.h"
+#include <stddef.h>
+#ifdef AESYS_MEP_GZIP
+    #include <zlib.h>
+#endif
 //---------------------------------------------------------------------
 
 #ifdef AESYS_MEP_EXPORTS
@@ -6,75 +10,539 @@
     DECLARE_LIB_VERSION(1,0,DRAFT-JCG);
 #endif
 
-#define K_CRC_MASK 0x8000
 #define K_POLYGEN  0x1021
 #define K_DINC     0x0080
 #define K_DSTX     0x0082
 #define K_DETX     0x0083
 #define K_DDLE     0x0090
 
+#define K_CPU_CLMUL        0x01
+#define K_CPU_AVX2         0x02
+#define K_CRC_CLMUL_MIN    0x0080
+#define K_ENC_BLOCK        0x0200
+#define K_UPTB_HEAD_SIZE   0x0007
+#define K_DEFRAMER_SYNC    0x00
+#define K_DEFRAMER_DATA    0x01
+#define K_CODE_HASH_MUL    0x160DED07
+#define K_CODE_HASH_SHIFT  25
+#define K_CODE_HASH_SLOTS  0x0080
+#define K_GET_CMD_SIZE     0x0006
+#define K_SET_CMD_SIZE     0x0008
+#define K_ANY_SIZE         0xFF
+#define K_UPTB_HEAD_ESC    0x0012  // Address, dlen, tran, cmd and CRC escaped.
+#define K_FIELD_U8         0x00
+#define K_FIELD_U16        0x01
+#define K_FIELD_U32        0x02
+#define K_FIELD_STRING     0x03
+#define K_FIELD_I8_WIDE    0x04
+#define K_FIELD_U8_WIDE    0x05
+#define K_CRC_FOLD_128     0xAEFC  // x^128 mod 0x11021
+#define K_CRC_FOLD_192     0x650B  // x^192 mod 0x11021
+#define K_CRC_FOLD_512     0x13FC  // x^512 mod 0x11021
+#define K_CRC_FOLD_576     0x8832  // x^576 mod 0x11021
+#define K_TXT_CMD          0x17    // Starts a drawing command of the text.
+#define K_TXT_ROW_MAX      0x001B  // Max drawing commands size of a row.
+#define K_BULK_PENDING     0x00
+#define K_BULK_FLIGHT      0x01
+#define K_BULK_DONE        0x02
+#define K_DAT_CMD_SIZE     0x0009
+#define K_GZIP_WBITS       (13+16) // 8 KiB window covers any payload. 16 selects gzip format.
+#define K_GUNZIP_WBITS     (15+16) // The sender can use any window.
+#define K_GZIP_MIN_SIZE    0x0012  // Gzip header and trailer.
+
+// SIMD kernels (CRC folding, escape bytes scanner). Only for x86-64. SSE2 is
+// always available, the other extensions are selected at runtime.
+#if defined(__x86_64__) || defined(_M_X64)
+    #define AESYS_MEP_X86_64
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #define MEP_TARGET(t)
+        static __inline unsigned int mepCtz(unsigned int v) { unsigned long i; _BitScanForward(&i,v); return i; }
+        #define MEP_CTZ(v) mepCtz(v)
+    #else
+        #include <cpuid.h>
+        #define MEP_TARGET(t) __attribute__ ((target(t)))
+        #define MEP_CTZ(v) __builtin_ctz(v)
+    #endif
+#endif
+
 #define GETVAL16(d,s,p) { d = (s[p] << 8 | s[p+1]); p+=2; }
 #define GETVAL32(d,s,p) { d = (((uint32_t) s[p+3] << 0)  | \
                                ((uint32_t) s[p+2] << 8)  | \
                                ((uint32_t) s[p+1] << 16) | \
                                ((uint32_t) s[p]   << 24)); p+=4; }
+
+#define CODE_HASH(c) (((uint32_t) (c) * K_CODE_HASH_MUL) >> K_CODE_HASH_SHIFT)
+
+#define OUTPUT_INIT(b,s) { .data = b, .size = ((b) != NULL && (s) != NULL) ? *(s) : 0, .result = -1, }
+//---------------------------------------------------------------------
+
+///
+/// \brief Destination of the frame built by createSendMEPFrame when it is
+///        written in a buffer provided by the developer.
+///
+typedef struct
+{
+    uint8_t *data;   ///< Caller buffer. NULL only for query the required size.
+    uint16_t size;   ///< Buffer capacity. On return the frame size or the required size.
+    char     result; ///< 1 frame written, 0 buffer too small, -1 invalid parameters.
+}tAESYS_MEP_OUTPUT;
+//---------------------------------------------------------------------
+
+///
+/// \brief Where a code of a grouped response is saved in the result struct.
+///        The bit in the "valid" member is the position of the field in the group.
+///
+typedef struct
+{
+    uint16_t code;   ///< The MEP code.
+    uint8_t  size;   ///< The expected data length. 0 for strings.
+    uint8_t  store;  ///< How the value is saved. See K_FIELD_XXX definitions.
+    uint16_t offset; ///< The position of the field in the result struct.
+}tAESYS_MEP_GROUP_FIELD;
+
+///
+/// \brief The codes of a grouped response and the sentinel code that
+///        starts the response. All result structs start with tran and valid.
+///
+typedef struct
+{
+    uint16_t code;                        ///< The MEP_CUSTOM_XXX_INFO_DATA code.
+    uint8_t  count;                       ///< Number of fields.
+    const tAESYS_MEP_GROUP_FIELD *fields; ///< The codes of the group.
+}tAESYS_MEP_GROUP;
+
+typedef struct
+{
+    uint16_t tran;
+    uint16_t valid;
+}tAESYS_MEP_GROUP_HEAD;
+
+///
+/// \brief Where the text of a row is saved in the data of a text publication.
+///
+typedef struct
+{
+    uint16_t offset; ///< Position of the first char in the data.
+    uint16_t size;   ///< Chars written. 0 if the row is not sent.
+}tAESYS_MEP_TEXT_SPAN;
+//---------------------------------------------------------------------
+
+/// Position of each code in records.
+#define RECORD_INDEX(name,code,nbne,iops,type) K_RECORD_##name,
+enum { AESYS_MEP_CODES_LIST(RECORD_INDEX) K_RECORDS_COUNT };
+#undef RECORD_INDEX
+
+#define RECORD_PROPERTIES(n,c,nb,io,t) { .code = c, .nbne = nb, .iops = io, .type = t, },
+static const tAESYS_MEP_CODE_PROPERTIES records[] =
+{
+    AESYS_MEP_CODES_LIST(RECORD_PROPERTIES)
+};
+#undef RECORD_PROPERTIES
+
+#define RECORD_NAME(name,code,nbne,iops,type) #name,
+static const char * const records_names[] =
+{
+    AESYS_MEP_CODES_LIST(RECORD_NAME)
+};
+#undef RECORD_NAME
+
+#define CUSTOM_NAME(name,code) #name,
+static const char * const custom_names[] =
+{
+    AESYS_MEP_CUSTOM_CODES_LIST(CUSTOM_NAME)
+};
+#undef CUSTOM_NAME
+
+/// Position of each custom code in custom_names. AesysMepGetCodeName finds the
+/// name by code - MEP_CUSTOM_SET_TEXT, so a code not consecutive doesn't compile.
+#define CUSTOM_INDEX(name,code) K_CUSTOM_##name,
+enum { AESYS_MEP_CUSTOM_CODES_LIST(CUSTOM_INDEX) K_CUSTOMS_COUNT };
+#undef CUSTOM_INDEX
+
+#define CUSTOM_CONSECUTIVE(name,code) typedef char custom_##name##_consecutive[(code == MEP_CUSTOM_SET_TEXT + K_CUSTOM_##name) ? 1 : -1];
+AESYS_MEP_CUSTOM_CODES_LIST(CUSTOM_CONSECUTIVE)
+#undef CUSTOM_CONSECUTIVE
+
+/// Perfect hash of the codes in records. CODE_HASH is unique for every code
+/// (checked when compile AesysMepGetCodeProperties), so records_hash[CODE_HASH(code)]
+/// is the position of the code in records plus one or 0 if there isn't a code with
+/// that hash. If a new code collides then search another odd K_CODE_HASH_MUL.
+#define RECORD_HASH(name,code,nbne,iops,type) [CODE_HASH(code)] = K_RECORD_##name + 1,
+static const uint8_t records_hash[K_CODE_HASH_SLOTS] =
+{
+    AESYS_MEP_CODES_LIST(RECORD_HASH)
+};
+#undef RECORD_HASH
+//---------------------------------------------------------------------
+
+/// Codes of the grouped responses. The order is the bit in the "valid" member
+/// of the result structs (see AESYS_MEP_DIAGNOSTIC_FIELDS).
+static const tAESYS_MEP_GROUP_FIELD diag_fields[] =
+{
+    { .code = MEP_DOORS_OPEN                , .size = 1, .store = K_FIELD_U8     , .offset = offsetof(tAESYS_MEP_DIAGNOSTIC_INFO,doors_open), },
+    { .code = MEP_POWER_SAVING_STATUS       , .size = 1, .store = K_FIELD_U8     , .offset = offsetof(tAESYS_MEP_DIAGNOSTIC_INFO,power_saving), },
+    { .code = MEP_BATTERY_LEVEL             , .size = 1, .store = K_FIELD_U8     , .offset = offsetof(tAESYS_MEP_DIAGNOSTIC_INFO,battery_level), },
+    { .code = MEP_FANS_ACTIVE               , .size = 1, .store = K_FIELD_U8     , .offset = offsetof(tAESYS_MEP_DIAGNOSTIC_INFO,fans_active), },
+    { .code = MEP_SIREN_ACTIVE              , .size = 1, .store = K_FIELD_U8     , .offset = offsetof(tAESYS_MEP_DIAGNOSTIC_INFO,siren_active), },
+    { .code = MEP_HEATING_ACTIVE            , .size = 1, .store = K_FIELD_U8     , .offset = offsetof(tAESYS_MEP_DIAGNOSTIC_INFO,heating_active), },
+    { .code = MEP_BROKEN_FANS_NUMBER        , .size = 1, .store = K_FIELD_U8     , .offset = offsetof(tAESYS_MEP_DIAGNOSTIC_INFO,broken_fans), },
+    { .code = MEP_BROKEN_BACKLIGHTS_NUMBER  , .size = 1, .store = K_FIELD_U8     , .offset = offsetof(tAESYS_MEP_DIAGNOSTIC_INFO,broken_backlights), },
+    { .code = MEP_INTERNAL_ERROR_CODE       , .size = 2, .store = K_FIELD_U16    , .offset = offsetof(tAESYS_MEP_DIAGNOSTIC_INFO,internal_error), },
+    { .code = MEP_NUM_BROKEN_LED_BOARDS     , .size = 2, .store = K_FIELD_U16    , .offset = offsetof(tAESYS_MEP_DIAGNOSTIC_INFO,broken_led_boards), },
+    { .code = MEP_BROKEN_LEDS_NUMBER        , .size = 4, .store = K_FIELD_U32    , .offset = offsetof(tAESYS_MEP_DIAGNOSTIC_INFO,broken_leds), },
+};
+
+static const tAESYS_MEP_GROUP_FIELD devinfo_fields[] =
+{
+    { .code = MEP_HARDWARE_MODEL            , .size = 0, .store = K_FIELD_STRING , .offset = offsetof(tAESYS_MEP_DEVICE_INFO,hardware_model), },
+    { .code = MEP_FIRMWARE_MODEL            , .size = 0, .store = K_FIELD_STRING , .offset = offsetof(tAESYS_MEP_DEVICE_INFO,firmware_model), },
+    { .code = MEP_FIRMWARE_VERSION          , .size = 0, .store = K_FIELD_STRING , .offset = offsetof(tAESYS_MEP_DEVICE_INFO,firmware_version), },
+    { .code = MEP_FIRMWARE_RELEASE          , .size = 0, .store = K_FIELD_STRING , .offset = offsetof(tAESYS_MEP_DEVICE_INFO,firmware_release), },
+    { .code = MEP_FIRMWARE_DEVICE_TYPE      , .size = 1, .store = K_FIELD_U8     , .offset = offsetof(tAESYS_MEP_DEVICE_INFO,device_type), },
+    { .code = MEP_DEVICE_ID                 , .size = 0, .store = K_FIELD_STRING , .offset = offsetof(tAESYS_MEP_DEVICE_INFO,device_id), },
+    { .code = MEP_DEVICE_DESCRIPTION        , .size = 0, .store = K_FIELD_STRING , .offset = offsetof(tAESYS_MEP_DEVICE_INFO,description), },
+};
+
+static const tAESYS_MEP_GROUP_FIELD temp_fields[] =
+{
+    { .code = MEP_TEMP_1                    , .size = 1, .store = K_FIELD_I8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[0]), },
+    { .code = MEP_TEMP_2                    , .size = 1, .store = K_FIELD_I8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[1]), },
+    { .code = MEP_TEMP_3                    , .size = 1, .store = K_FIELD_I8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[2]), },
+    { .code = MEP_TEMP_4                    , .size = 1, .store = K_FIELD_I8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[3]), },
+    { .code = MEP_TEMP_5                    , .size = 1, .store = K_FIELD_I8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[4]), },
+    { .code = MEP_TEMP_6                    , .size = 1, .store = K_FIELD_I8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[5]), },
+    { .code = MEP_TEMP_7                    , .size = 1, .store = K_FIELD_I8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[6]), },
+    { .code = MEP_TEMP_8                    , .size = 1, .store = K_FIELD_I8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[7]), },
+};
+
+static const tAESYS_MEP_GROUP_FIELD hum_fields[] =
+{
+    { .code = MEP_HUMIDITY_1                , .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[0]), },
+    { .code = MEP_HUMIDITY_2                , .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[1]), },
+    { .code = MEP_HUMIDITY_3                , .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[2]), },
+    { .code = MEP_HUMIDITY_4                , .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[3]), },
+};
+
+static const tAESYS_MEP_GROUP_FIELD bright_fields[] =
+{
+    { .code = MEP_BRIGHTNESS_1              , .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[0]), },
+    { .code = MEP_BRIGHTNESS_2              , .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[1]), },
+    { .code = MEP_BRIGHTNESS_3              , .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[2]), },
+    { .code = MEP_BRIGHTNESS_4              , .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[3]), },
+};
+
+static const tAESYS_MEP_GROUP_FIELD ebright_fields[] =
+{
+    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_1, .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[0]), },
+    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_2, .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[1]), },
+    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_3, .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[2]), },
+    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_4, .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[3]), },
+    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_5, .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[4]), },
+    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_6, .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[5]), },
+    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_7, .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[6]), },
+    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_8, .size = 1, .store = K_FIELD_U8_WIDE, .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[7]), },
+};
+
+static const tAESYS_MEP_GROUP_FIELD traffic_fields[] =
+{
+    { .code = MEP_TRAFFIC_LIGHT_STATUS_1    , .size = 2, .store = K_FIELD_U16    , .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[0]), },
+    { .code = MEP_TRAFFIC_LIGHT_STATUS_2    , .size = 2, .store = K_FIELD_U16    , .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[1]), },
+    { .code = MEP_TRAFFIC_LIGHT_STATUS_3    , .size = 2, .store = K_FIELD_U16    , .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[2]), },
+    { .code = MEP_TRAFFIC_LIGHT_STATUS_4    , .size = 2, .store = K_FIELD_U16    , .offset = offsetof(tAESYS_MEP_SENSORS_INFO,values[3]), },
+};
+
+static const tAESYS_MEP_GROUP diag_group    = { .code = MEP_CUSTOM_DIAGNOSTIC_INFO_DATA , .count = 11, .fields = diag_fields   , };
+static const tAESYS_MEP_GROUP devinfo_group = { .code = MEP_CUSTOM_DEVICE_INFO_DATA     , .count = 7 , .fields = devinfo_fields, };
+static const tAESYS_MEP_GROUP temp_group    = { .code = MEP_CUSTOM_TEMPERATURE_INFO_DATA, .count = 8 , .fields = temp_fields   , };
+static const tAESYS_MEP_GROUP hum_group     = { .code = MEP_CUSTOM_HUMIDITY_INFO_DATA   , .count = 4 , .fields = hum_fields    , };
+static const tAESYS_MEP_GROUP bright_group  = { .code = MEP_CUSTOM_BRIGHTNESS_INFO_DATA , .count = 4 , .fields = bright_fields , };
+static const tAESYS_MEP_GROUP ebright_group = { .code = MEP_CUSTOM_EBRIGHTNESS_INFO_DATA, .count = 8 , .fields = ebright_fields, };
+static const tAESYS_MEP_GROUP traffic_group = { .code = MEP_CUSTOM_TRAFFIC_INFO_DATA    , .count = 4 , .fields = traffic_fields, };
+//---------------------------------------------------------------------
+
+/// Digits of the hex positions in the text drawing commands.
+static const uint8_t hex_digits[16] = {'0','1','2','3','4','5','6','7','8','9','A','B','C','D','E','F'};
 //---------------------------------------------------------------------
 
-tAESYS_MEP_CODE_PROPERTIES records[] =
-{
-    { .code = MEP_STATUS                    , .nbne = 0, .iops = MEP_RD, .type = MEP_VOID    , },
-    { .code = MEP_HARDWARE_MODEL            , .nbne = 0, .iops = MEP_RD, .type = MEP_STRING  , },
-    { .code = MEP_FIRMWARE_MODEL            , .nbne = 0, .iops = MEP_RD, .type = MEP_STRING  , },
-    { .code = MEP_FIRMWARE_VERSION          , .nbne = 0, .iops = MEP_RD, .type = MEP_STRING  , },
-    { .code = MEP_FIRMWARE_RELEASE          , .nbne = 0, .iops = MEP_RD, .type = MEP_STRING  , },
-    { .code = MEP_FIRMWARE_DEVICE_TYPE      , .nbne = 0, .iops = MEP_RW, .type = MEP_UINT8   , },
-    { .code = MEP_DEVICE_ID                 , .nbne = 0, .iops = MEP_RW, .type = MEP_STRING  , },
-    { .code = MEP_DEVICE_DESCRIPTION        , .nbne = 1, .iops = MEP_RW, .type = MEP_STRING  , },
-    { .code = MEP_RESET                     , .nbne = 0, .iops = MEP_WR, .type = MEP_VOID    , },
-    { .code = MEP_VIS_EXTENSIBLE            , .nbne = 0, .iops = MEP_RW, .type = MEP_BINARY  , },
-    { .code = MEP_TEMP_1                    , .nbne = 0, .iops = MEP_RD, .type = MEP_INT8    , },
-    { .code = MEP_TEMP_2                    , .nbne = 0, .iops = MEP_RD, .type = MEP_INT8    , },
-    { .code = MEP_TEMP_3                    , .nbne = 0, .iops = MEP_RD, .type = MEP_INT8    , },
-    { .code = MEP_TEMP_4                    , .nbne = 0, .iops = MEP_RD, .type = MEP_INT8    , },
-    { .code = MEP_TEMP_5                    , .nbne = 0, .iops = MEP_RD, .type = MEP_INT8    , },
-    { .code = MEP_TEMP_6                    , .nbne = 0, .iops = MEP_RD, .type = MEP_INT8    , },
-    { .code = MEP_TEMP_7                    , .nbne = 0, .iops = MEP_RD, .type = MEP_INT8    , },
-    { .code = MEP_TEMP_8                    , .nbne = 0, .iops = MEP_RD, .type = MEP_INT8    , },
-    { .code = MEP_HUMIDITY_1                , .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_HUMIDITY_2                , .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_HUMIDITY_3                , .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_HUMIDITY_4                , .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_1, .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_2, .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_3, .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_4, .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_5, .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_6, .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_7, .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_ENVIRONMENTAL_BRIGHTNESS_8, .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_DEVICE_RESTARTED          , .nbne = 0, .iops = MEP_RD, .type = MEP_BOOL    , },
-    { .code = MEP_DOORS_OPEN                , .nbne = 0, .iops = MEP_RD, .type = MEP_BOOL    , },
-    { .code = MEP_INTERNAL_ERROR_CODE       , .nbne = 0, .iops = MEP_RD, .type = MEP_UINT16  , },
-    { .code = MEP_POWER_SAVING_STATUS       , .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_BATTERY_LEVEL             , .nbne = 0, .iops = MEP_RW, .type = MEP_UINT8   , },
-    { .code = MEP_FANS_ACTIVE               , .nbne = 0, .iops = MEP_RD, .type = MEP_BOOL    , },
-    { .code = MEP_HEATING_ACTIVE            , .nbne = 0, .iops = MEP_RD, .type = MEP_BOOL    , },
-    { .code = MEP_SIREN_ACTIVE              , .nbne = 0, .iops = MEP_RD, .type = MEP_BOOL    , },
-    { .code = MEP_BROKEN_FANS_NUMBER        , .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_BROKEN_LEDS_NUMBER        , .nbne = 0, .iops = MEP_RD, .type = MEP_UINT32  , },
-    { .code = MEP_BROKEN_BACKLIGHTS_NUMBER  , .nbne = 0, .iops = MEP_RD, .type = MEP_UINT8   , },
-    { .code = MEP_NUM_BROKEN_LED_BOARDS     , .nbne = 0, .iops = MEP_RD, .type = MEP_UINT16  , },
-    { .code = MEP_CLOCK                     , .nbne = 0, .iops = MEP_RW, .type = MEP_BINARY  , },
-    { .code = MEP_COLORS_CALIBRATION        , .nbne = 0, .iops = MEP_RW, .type = MEP_BINARY  , },
-    { .code = MEP_REMEMBER_LAST_PUBLICATION , .nbne = 0, .iops = MEP_RW, .type = MEP_BOOL    , },
-    { .code = MEP_BRIGHTNESS_1              , .nbne = 0, .iops = MEP_RW, .type = MEP_UINT8   , },
-    { .code = MEP_BRIGHTNESS_2              , .nbne = 0, .iops = MEP_RW, .type = MEP_UINT8   , },
-    { .code = MEP_BRIGHTNESS_3              , .nbne = 0, .iops = MEP_RW, .type = MEP_UINT8   , },
-    { .code = MEP_BRIGHTNESS_4              , .nbne = 0, .iops = MEP_RW, .type = MEP_UINT8   , },
-    { .code = MEP_TRAFFIC_LIGHT_STATUS_1    , .nbne = 0, .iops = MEP_RW, .type = MEP_BINARY  , },
-    { .code = MEP_TRAFFIC_LIGHT_STATUS_2    , .nbne = 0, .iops = MEP_RW, .type = MEP_BINARY  , },
-    { .code = MEP_TRAFFIC_LIGHT_STATUS_3    , .nbne = 0, .iops = MEP_RW, .type = MEP_BINARY  , },
-    { .code = MEP_TRAFFIC_LIGHT_STATUS_4    , .nbne = 0, .iops = MEP_RW, .type = MEP_BINARY  , },
+/// CRC-CCITT (poly 0x1021) lookup tables for the slicing-by-8 algorithm.
+/// crc_table[0] is the classic byte table and crc_table[k][i] is the CRC
+/// of the byte i followed by k zero bytes.
+static const uint16_t crc_table[8][256] =
+{
+    {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+        0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+        0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+        0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+        0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+        0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+        0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+        0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+        0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+        0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+        0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+        0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+        0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+        0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+        0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+        0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+        0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+        0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+        0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+        0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+        0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+        0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+        0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+        0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+        0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+        0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+        0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+        0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+        0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+        0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+        0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+    },
+    {
+        0x0000, 0x3331, 0x6662, 0x5553, 0xCCC4, 0xFFF5, 0xAAA6, 0x9997,
+        0x89A9, 0xBA98, 0xEFCB, 0xDCFA, 0x456D, 0x765C, 0x230F, 0x103E,
+        0x0373, 0x3042, 0x6511, 0x5620, 0xCFB7, 0xFC86, 0xA9D5, 0x9AE4,
+        0x8ADA, 0xB9EB, 0xECB8, 0xDF89, 0x461E, 0x752F, 0x207C, 0x134D,
+        0x06E6, 0x35D7, 0x6084, 0x53B5, 0xCA22, 0xF913, 0xAC40, 0x9F71,
+        0x8F4F, 0xBC7E, 0xE92D, 0xDA1C, 0x438B, 0x70BA, 0x25E9, 0x16D8,
+        0x0595, 0x36A4, 0x63F7, 0x50C6, 0xC951, 0xFA60, 0xAF33, 0x9C02,
+        0x8C3C, 0xBF0D, 0xEA5E, 0xD96F, 0x40F8, 0x73C9, 0x269A, 0x15AB,
+        0x0DCC, 0x3EFD, 0x6BAE, 0x589F, 0xC108, 0xF239, 0xA76A, 0x945B,
+        0x8465, 0xB754, 0xE207, 0xD136, 0x48A1, 0x7B90, 0x2EC3, 0x1DF2,
+        0x0EBF, 0x3D8E, 0x68DD, 0x5BEC, 0xC27B, 0xF14A, 0xA419, 0x9728,
+        0x8716, 0xB427, 0xE174, 0xD245, 0x4BD2, 0x78E3, 0x2DB0, 0x1E81,
+        0x0B2A, 0x381B, 0x6D48, 0x5E79, 0xC7EE, 0xF4DF, 0xA18C, 0x92BD,
+        0x8283, 0xB1B2, 0xE4E1, 0xD7D0, 0x4E47, 0x7D76, 0x2825, 0x1B14,
+        0x0859, 0x3B68, 0x6E3B, 0x5D0A, 0xC49D, 0xF7AC, 0xA2FF, 0x91CE,
+        0x81F0, 0xB2C1, 0xE792, 0xD4A3, 0x4D34, 0x7E05, 0x2B56, 0x1867,
+        0x1B98, 0x28A9, 0x7DFA, 0x4ECB, 0xD75C, 0xE46D, 0xB13E, 0x820F,
+        0x9231, 0xA100, 0xF453, 0xC762, 0x5EF5, 0x6DC4, 0x3897, 0x0BA6,
+        0x18EB, 0x2BDA, 0x7E89, 0x4DB8, 0xD42F, 0xE71E, 0xB24D, 0x817C,
+        0x9142, 0xA273, 0xF720, 0xC411, 0x5D86, 0x6EB7, 0x3BE4, 0x08D5,
+        0x1D7E, 0x2E4F, 0x7B1C, 0x482D, 0xD1BA, 0xE28B, 0xB7D8, 0x84E9,
+        0x94D7, 0xA7E6, 0xF2B5, 0xC184, 0x5813, 0x6B22, 0x3E71, 0x0D40,
+        0x1E0D, 0x2D3C, 0x786F, 0x4B5E, 0xD2C9, 0xE1F8, 0xB4AB, 0x879A,
+        0x97A4, 0xA495, 0xF1C6, 0xC2F7, 0x5B60, 0x6851, 0x3D02, 0x0E33,
+        0x1654, 0x2565, 0x7036, 0x4307, 0xDA90, 0xE9A1, 0xBCF2, 0x8FC3,
+        0x9FFD, 0xACCC, 0xF99F, 0xCAAE, 0x5339, 0x6008, 0x355B, 0x066A,
+        0x1527, 0x2616, 0x7345, 0x4074, 0xD9E3, 0xEAD2, 0xBF81, 0x8CB0,
+        0x9C8E, 0xAFBF, 0xFAEC, 0xC9DD, 0x504A, 0x637B, 0x3628, 0x0519,
+        0x10B2, 0x2383, 0x76D0, 0x45E1, 0xDC76, 0xEF47, 0xBA14, 0x8925,
+        0x991B, 0xAA2A, 0xFF79, 0xCC48, 0x55DF, 0x66EE, 0x33BD, 0x008C,
+        0x13C1, 0x20F0, 0x75A3, 0x4692, 0xDF05, 0xEC34, 0xB967, 0x8A56,
+        0x9A68, 0xA959, 0xFC0A, 0xCF3B, 0x56AC, 0x659D, 0x30CE, 0x03FF,
+    },
+    {
+        0x0000, 0x3730, 0x6E60, 0x5950, 0xDCC0, 0xEBF0, 0xB2A0, 0x8590,
+        0xA9A1, 0x9E91, 0xC7C1, 0xF0F1, 0x7561, 0x4251, 0x1B01, 0x2C31,
+        0x4363, 0x7453, 0x2D03, 0x1A33, 0x9FA3, 0xA893, 0xF1C3, 0xC6F3,
+        0xEAC2, 0xDDF2, 0x84A2, 0xB392, 0x3602, 0x0132, 0x5862, 0x6F52,
+        0x86C6, 0xB1F6, 0xE8A6, 0xDF96, 0x5A06, 0x6D36, 0x3466, 0x0356,
+        0x2F67, 0x1857, 0x4107, 0x7637, 0xF3A7, 0xC497, 0x9DC7, 0xAAF7,
+        0xC5A5, 0xF295, 0xABC5, 0x9CF5, 0x1965, 0x2E55, 0x7705, 0x4035,
+        0x6C04, 0x5B34, 0x0264, 0x3554, 0xB0C4, 0x87F4, 0xDEA4, 0xE994,
+        0x1DAD, 0x2A9D, 0x73CD, 0x44FD, 0xC16D, 0xF65D, 0xAF0D, 0x983D,
+        0xB40C, 0x833C, 0xDA6C, 0xED5C, 0x68CC, 0x5FFC, 0x06AC, 0x319C,
+        0x5ECE, 0x69FE, 0x30AE, 0x079E, 0x820E, 0xB53E, 0xEC6E, 0xDB5E,
+        0xF76F, 0xC05F, 0x990F, 0xAE3F, 0x2BAF, 0x1C9F, 0x45CF, 0x72FF,
+        0x9B6B, 0xAC5B, 0xF50B, 0xC23B, 0x47AB, 0x709B, 0x29CB, 0x1EFB,
+        0x32CA, 0x05FA, 0x5CAA, 0x6B9A, 0xEE0A, 0xD93A, 0x806A, 0xB75A,
+        0xD808, 0xEF38, 0xB668, 0x8158, 0x04C8, 0x33F8, 0x6AA8, 0x5D98,
+        0x71A9, 0x4699, 0x1FC9, 0x28F9, 0xAD69, 0x9A59, 0xC309, 0xF439,
+        0x3B5A, 0x0C6A, 0x553A, 0x620A, 0xE79A, 0xD0AA, 0x89FA, 0xBECA,
+        0x92FB, 0xA5CB, 0xFC9B, 0xCBAB, 0x4E3B, 0x790B, 0x205B, 0x176B,
+        0x7839, 0x4F09, 0x1659, 0x2169, 0xA4F9, 0x93C9, 0xCA99, 0xFDA9,
+        0xD198, 0xE6A8, 0xBFF8, 0x88C8, 0x0D58, 0x3A68, 0x6338, 0x5408,
+        0xBD9C, 0x8AAC, 0xD3FC, 0xE4CC, 0x615C, 0x566C, 0x0F3C, 0x380C,
+        0x143D, 0x230D, 0x7A5D, 0x4D6D, 0xC8FD, 0xFFCD, 0xA69D, 0x91AD,
+        0xFEFF, 0xC9CF, 0x909F, 0xA7AF, 0x223F, 0x150F, 0x4C5F, 0x7B6F,
+        0x575E, 0x606E, 0x393E, 0x0E0E, 0x8B9E, 0xBCAE, 0xE5FE, 0xD2CE,
+        0x26F7, 0x11C7, 0x4897, 0x7FA7, 0xFA37, 0xCD07, 0x9457, 0xA367,
+        0x8F56, 0xB866, 0xE136, 0xD606, 0x5396, 0x64A6, 0x3DF6, 0x0AC6,
+        0x6594, 0x52A4, 0x0BF4, 0x3CC4, 0xB954, 0x8E64, 0xD734, 0xE004,
+        0xCC35, 0xFB05, 0xA255, 0x9565, 0x10F5, 0x27C5, 0x7E95, 0x49A5,
+        0xA031, 0x9701, 0xCE51, 0xF961, 0x7CF1, 0x4BC1, 0x1291, 0x25A1,
+        0x0990, 0x3EA0, 0x67F0, 0x50C0, 0xD550, 0xE260, 0xBB30, 0x8C00,
+        0xE352, 0xD462, 0x8D32, 0xBA02, 0x3F92, 0x08A2, 0x51F2, 0x66C2,
+        0x4AF3, 0x7DC3, 0x2493, 0x13A3, 0x9633, 0xA103, 0xF853, 0xCF63,
+    },
+    {
+        0x0000, 0x76B4, 0xED68, 0x9BDC, 0xCAF1, 0xBC45, 0x2799, 0x512D,
+        0x85C3, 0xF377, 0x68AB, 0x1E1F, 0x4F32, 0x3986, 0xA25A, 0xD4EE,
+        0x1BA7, 0x6D13, 0xF6CF, 0x807B, 0xD156, 0xA7E2, 0x3C3E, 0x4A8A,
+        0x9E64, 0xE8D0, 0x730C, 0x05B8, 0x5495, 0x2221, 0xB9FD, 0xCF49,
+        0x374E, 0x41FA, 0xDA26, 0xAC92, 0xFDBF, 0x8B0B, 0x10D7, 0x6663,
+        0xB28D, 0xC439, 0x5FE5, 0x2951, 0x787C, 0x0EC8, 0x9514, 0xE3A0,
+        0x2CE9, 0x5A5D, 0xC181, 0xB735, 0xE618, 0x90AC, 0x0B70, 0x7DC4,
+        0xA92A, 0xDF9E, 0x4442, 0x32F6, 0x63DB, 0x156F, 0x8EB3, 0xF807,
+        0x6E9C, 0x1828, 0x83F4, 0xF540, 0xA46D, 0xD2D9, 0x4905, 0x3FB1,
+        0xEB5F, 0x9DEB, 0x0637, 0x7083, 0x21AE, 0x571A, 0xCCC6, 0xBA72,
+        0x753B, 0x038F, 0x9853, 0xEEE7, 0xBFCA, 0xC97E, 0x52A2, 0x2416,
+        0xF0F8, 0x864C, 0x1D90, 0x6B24, 0x3A09, 0x4CBD, 0xD761, 0xA1D5,
+        0x59D2, 0x2F66, 0xB4BA, 0xC20E, 0x9323, 0xE597, 0x7E4B, 0x08FF,
+        0xDC11, 0xAAA5, 0x3179, 0x47CD, 0x16E0, 0x6054, 0xFB88, 0x8D3C,
+        0x4275, 0x34C1, 0xAF1D, 0xD9A9, 0x8884, 0xFE30, 0x65EC, 0x1358,
+        0xC7B6, 0xB102, 0x2ADE, 0x5C6A, 0x0D47, 0x7BF3, 0xE02F, 0x969B,
+        0xDD38, 0xAB8C, 0x3050, 0x46E4, 0x17C9, 0x617D, 0xFAA1, 0x8C15,
+        0x58FB, 0x2E4F, 0xB593, 0xC327, 0x920A, 0xE4BE, 0x7F62, 0x09D6,
+        0xC69F, 0xB02B, 0x2BF7, 0x5D43, 0x0C6E, 0x7ADA, 0xE106, 0x97B2,
+        0x435C, 0x35E8, 0xAE34, 0xD880, 0x89AD, 0xFF19, 0x64C5, 0x1271,
+        0xEA76, 0x9CC2, 0x071E, 0x71AA, 0x2087, 0x5633, 0xCDEF, 0xBB5B,
+        0x6FB5, 0x1901, 0x82DD, 0xF469, 0xA544, 0xD3F0, 0x482C, 0x3E98,
+        0xF1D1, 0x8765, 0x1CB9, 0x6A0D, 0x3B20, 0x4D94, 0xD648, 0xA0FC,
+        0x7412, 0x02A6, 0x997A, 0xEFCE, 0xBEE3, 0xC857, 0x538B, 0x253F,
+        0xB3A4, 0xC510, 0x5ECC, 0x2878, 0x7955, 0x0FE1, 0x943D, 0xE289,
+        0x3667, 0x40D3, 0xDB0F, 0xADBB, 0xFC96, 0x8A22, 0x11FE, 0x674A,
+        0xA803, 0xDEB7, 0x456B, 0x33DF, 0x62F2, 0x1446, 0x8F9A, 0xF92E,
+        0x2DC0, 0x5B74, 0xC0A8, 0xB61C, 0xE731, 0x9185, 0x0A59, 0x7CED,
+        0x84EA, 0xF25E, 0x6982, 0x1F36, 0x4E1B, 0x38AF, 0xA373, 0xD5C7,
+        0x0129, 0x779D, 0xEC41, 0x9AF5, 0xCBD8, 0xBD6C, 0x26B0, 0x5004,
+        0x9F4D, 0xE9F9, 0x7225, 0x0491, 0x55BC, 0x2308, 0xB8D4, 0xCE60,
+        0x1A8E, 0x6C3A, 0xF7E6, 0x8152, 0xD07F, 0xA6CB, 0x3D17, 0x4BA3,
+    },
+    {
+        0x0000, 0xAA51, 0x4483, 0xEED2, 0x8906, 0x2357, 0xCD85, 0x67D4,
+        0x022D, 0xA87C, 0x46AE, 0xECFF, 0x8B2B, 0x217A, 0xCFA8, 0x65F9,
+        0x045A, 0xAE0B, 0x40D9, 0xEA88, 0x8D5C, 0x270D, 0xC9DF, 0x638E,
+        0x0677, 0xAC26, 0x42F4, 0xE8A5, 0x8F71, 0x2520, 0xCBF2, 0x61A3,
+        0x08B4, 0xA2E5, 0x4C37, 0xE666, 0x81B2, 0x2BE3, 0xC531, 0x6F60,
+        0x0A99, 0xA0C8, 0x4E1A, 0xE44B, 0x839F, 0x29CE, 0xC71C, 0x6D4D,
+        0x0CEE, 0xA6BF, 0x486D, 0xE23C, 0x85E8, 0x2FB9, 0xC16B, 0x6B3A,
+        0x0EC3, 0xA492, 0x4A40, 0xE011, 0x87C5, 0x2D94, 0xC346, 0x6917,
+        0x1168, 0xBB39, 0x55EB, 0xFFBA, 0x986E, 0x323F, 0xDCED, 0x76BC,
+        0x1345, 0xB914, 0x57C6, 0xFD97, 0x9A43, 0x3012, 0xDEC0, 0x7491,
+        0x1532, 0xBF63, 0x51B1, 0xFBE0, 0x9C34, 0x3665, 0xD8B7, 0x72E6,
+        0x171F, 0xBD4E, 0x539C, 0xF9CD, 0x9E19, 0x3448, 0xDA9A, 0x70CB,
+        0x19DC, 0xB38D, 0x5D5F, 0xF70E, 0x90DA, 0x3A8B, 0xD459, 0x7E08,
+        0x1BF1, 0xB1A0, 0x5F72, 0xF523, 0x92F7, 0x38A6, 0xD674, 0x7C25,
+        0x1D86, 0xB7D7, 0x5905, 0xF354, 0x9480, 0x3ED1, 0xD003, 0x7A52,
+        0x1FAB, 0xB5FA, 0x5B28, 0xF179, 0x96AD, 0x3CFC, 0xD22E, 0x787F,
+        0x22D0, 0x8881, 0x6653, 0xCC02, 0xABD6, 0x0187, 0xEF55, 0x4504,
+        0x20FD, 0x8AAC, 0x647E, 0xCE2F, 0xA9FB, 0x03AA, 0xED78, 0x4729,
+        0x268A, 0x8CDB, 0x6209, 0xC858, 0xAF8C, 0x05DD, 0xEB0F, 0x415E,
+        0x24A7, 0x8EF6, 0x6024, 0xCA75, 0xADA1, 0x07F0, 0xE922, 0x4373,
+        0x2A64, 0x8035, 0x6EE7, 0xC4B6, 0xA362, 0x0933, 0xE7E1, 0x4DB0,
+        0x2849, 0x8218, 0x6CCA, 0xC69B, 0xA14F, 0x0B1E, 0xE5CC, 0x4F9D,
+        0x2E3E, 0x846F, 0x6ABD, 0xC0EC, 0xA738, 0x0D69, 0xE3BB, 0x49EA,
+        0x2C13, 0x8642, 0x6890, 0xC2C1, 0xA515, 0x0F44, 0xE196, 0x4BC7,
+        0x33B8, 0x99E9, 0x773B, 0xDD6A, 0xBABE, 0x10EF, 0xFE3D, 0x546C,
+        0x3195, 0x9BC4, 0x7516, 0xDF47, 0xB893, 0x12C2, 0xFC10, 0x5641,
+        0x37E2, 0x9DB3, 0x7361, 0xD930, 0xBEE4, 0x14B5, 0xFA67, 0x5036,
+        0x35CF, 0x9F9E, 0x714C, 0xDB1D, 0xBCC9, 0x1698, 0xF84A, 0x521B,
+        0x3B0C, 0x915D, 0x7F8F, 0xD5DE, 0xB20A, 0x185B, 0xF689, 0x5CD8,
+        0x3921, 0x9370, 0x7DA2, 0xD7F3, 0xB027, 0x1A76, 0xF4A4, 0x5EF5,
+        0x3F56, 0x9507, 0x7BD5, 0xD184, 0xB650, 0x1C01, 0xF2D3, 0x5882,
+        0x3D7B, 0x972A, 0x79F8, 0xD3A9, 0xB47D, 0x1E2C, 0xF0FE, 0x5AAF,
+    },
+    {
+        0x0000, 0x45A0, 0x8B40, 0xCEE0, 0x06A1, 0x4301, 0x8DE1, 0xC841,
+        0x0D42, 0x48E2, 0x8602, 0xC3A2, 0x0BE3, 0x4E43, 0x80A3, 0xC503,
+        0x1A84, 0x5F24, 0x91C4, 0xD464, 0x1C25, 0x5985, 0x9765, 0xD2C5,
+        0x17C6, 0x5266, 0x9C86, 0xD926, 0x1167, 0x54C7, 0x9A27, 0xDF87,
+        0x3508, 0x70A8, 0xBE48, 0xFBE8, 0x33A9, 0x7609, 0xB8E9, 0xFD49,
+        0x384A, 0x7DEA, 0xB30A, 0xF6AA, 0x3EEB, 0x7B4B, 0xB5AB, 0xF00B,
+        0x2F8C, 0x6A2C, 0xA4CC, 0xE16C, 0x292D, 0x6C8D, 0xA26D, 0xE7CD,
+        0x22CE, 0x676E, 0xA98E, 0xEC2E, 0x246F, 0x61CF, 0xAF2F, 0xEA8F,
+        0x6A10, 0x2FB0, 0xE150, 0xA4F0, 0x6CB1, 0x2911, 0xE7F1, 0xA251,
+        0x6752, 0x22F2, 0xEC12, 0xA9B2, 0x61F3, 0x2453, 0xEAB3, 0xAF13,
+        0x7094, 0x3534, 0xFBD4, 0xBE74, 0x7635, 0x3395, 0xFD75, 0xB8D5,
+        0x7DD6, 0x3876, 0xF696, 0xB336, 0x7B77, 0x3ED7, 0xF037, 0xB597,
+        0x5F18, 0x1AB8, 0xD458, 0x91F8, 0x59B9, 0x1C19, 0xD2F9, 0x9759,
+        0x525A, 0x17FA, 0xD91A, 0x9CBA, 0x54FB, 0x115B, 0xDFBB, 0x9A1B,
+        0x459C, 0x003C, 0xCEDC, 0x8B7C, 0x433D, 0x069D, 0xC87D, 0x8DDD,
+        0x48DE, 0x0D7E, 0xC39E, 0x863E, 0x4E7F, 0x0BDF, 0xC53F, 0x809F,
+        0xD420, 0x9180, 0x5F60, 0x1AC0, 0xD281, 0x9721, 0x59C1, 0x1C61,
+        0xD962, 0x9CC2, 0x5222, 0x1782, 0xDFC3, 0x9A63, 0x5483, 0x1123,
+        0xCEA4, 0x8B04, 0x45E4, 0x0044, 0xC805, 0x8DA5, 0x4345, 0x06E5,
+        0xC3E6, 0x8646, 0x48A6, 0x0D06, 0xC547, 0x80E7, 0x4E07, 0x0BA7,
+        0xE128, 0xA488, 0x6A68, 0x2FC8, 0xE789, 0xA229, 0x6CC9, 0x2969,
+        0xEC6A, 0xA9CA, 0x672A, 0x228A, 0xEACB, 0xAF6B, 0x618B, 0x242B,
+        0xFBAC, 0xBE0C, 0x70EC, 0x354C, 0xFD0D, 0xB8AD, 0x764D, 0x33ED,
+        0xF6EE, 0xB34E, 0x7DAE, 0x380E, 0xF04F, 0xB5EF, 0x7B0F, 0x3EAF,
+        0xBE30, 0xFB90, 0x3570, 0x70D0, 0xB891, 0xFD31, 0x33D1, 0x7671,
+        0xB372, 0xF6D2, 0x3832, 0x7D92, 0xB5D3, 0xF073, 0x3E93, 0x7B33,
+        0xA4B4, 0xE114, 0x2FF4, 0x6A54, 0xA215, 0xE7B5, 0x2955, 0x6CF5,
+        0xA9F6, 0xEC56, 0x22B6, 0x6716, 0xAF57, 0xEAF7, 0x2417, 0x61B7,
+        0x8B38, 0xCE98, 0x0078, 0x45D8, 0x8D99, 0xC839, 0x06D9, 0x4379,
+        0x867A, 0xC3DA, 0x0D3A, 0x489A, 0x80DB, 0xC57B, 0x0B9B, 0x4E3B,
+        0x91BC, 0xD41C, 0x1AFC, 0x5F5C, 0x971D, 0xD2BD, 0x1C5D, 0x59FD,
+        0x9CFE, 0xD95E, 0x17BE, 0x521E, 0x9A5F, 0xDFFF, 0x111F, 0x54BF,
+    },
+    {
+        0x0000, 0xB861, 0x60E3, 0xD882, 0xC1C6, 0x79A7, 0xA125, 0x1944,
+        0x93AD, 0x2BCC, 0xF34E, 0x4B2F, 0x526B, 0xEA0A, 0x3288, 0x8AE9,
+        0x377B, 0x8F1A, 0x5798, 0xEFF9, 0xF6BD, 0x4EDC, 0x965E, 0x2E3F,
+        0xA4D6, 0x1CB7, 0xC435, 0x7C54, 0x6510, 0xDD71, 0x05F3, 0xBD92,
+        0x6EF6, 0xD697, 0x0E15, 0xB674, 0xAF30, 0x1751, 0xCFD3, 0x77B2,
+        0xFD5B, 0x453A, 0x9DB8, 0x25D9, 0x3C9D, 0x84FC, 0x5C7E, 0xE41F,
+        0x598D, 0xE1EC, 0x396E, 0x810F, 0x984B, 0x202A, 0xF8A8, 0x40C9,
+        0xCA20, 0x7241, 0xAAC3, 0x12A2, 0x0BE6, 0xB387, 0x6B05, 0xD364,
+        0xDDEC, 0x658D, 0xBD0F, 0x056E, 0x1C2A, 0xA44B, 0x7CC9, 0xC4A8,
+        0x4E41, 0xF620, 0x2EA2, 0x96C3, 0x8F87, 0x37E6, 0xEF64, 0x5705,
+        0xEA97, 0x52F6, 0x8A74, 0x3215, 0x2B51, 0x9330, 0x4BB2, 0xF3D3,
+        0x793A, 0xC15B, 0x19D9, 0xA1B8, 0xB8FC, 0x009D, 0xD81F, 0x607E,
+        0xB31A, 0x0B7B, 0xD3F9, 0x6B98, 0x72DC, 0xCABD, 0x123F, 0xAA5E,
+        0x20B7, 0x98D6, 0x4054, 0xF835, 0xE171, 0x5910, 0x8192, 0x39F3,
+        0x8461, 0x3C00, 0xE482, 0x5CE3, 0x45A7, 0xFDC6, 0x2544, 0x9D25,
+        0x17CC, 0xAFAD, 0x772F, 0xCF4E, 0xD60A, 0x6E6B, 0xB6E9, 0x0E88,
+        0xABF9, 0x1398, 0xCB1A, 0x737B, 0x6A3F, 0xD25E, 0x0ADC, 0xB2BD,
+        0x3854, 0x8035, 0x58B7, 0xE0D6, 0xF992, 0x41F3, 0x9971, 0x2110,
+        0x9C82, 0x24E3, 0xFC61, 0x4400, 0x5D44, 0xE525, 0x3DA7, 0x85C6,
+        0x0F2F, 0xB74E, 0x6FCC, 0xD7AD, 0xCEE9, 0x7688, 0xAE0A, 0x166B,
+        0xC50F, 0x7D6E, 0xA5EC, 0x1D8D, 0x04C9, 0xBCA8, 0x642A, 0xDC4B,
+        0x56A2, 0xEEC3, 0x3641, 0x8E20, 0x9764, 0x2F05, 0xF787, 0x4FE6,
+        0xF274, 0x4A15, 0x9297, 0x2AF6, 0x33B2, 0x8BD3, 0x5351, 0xEB30,
+        0x61D9, 0xD9B8, 0x013A, 0xB95B, 0xA01F, 0x187E, 0xC0FC, 0x789D,
+        0x7615, 0xCE74, 0x16F6, 0xAE97, 0xB7D3, 0x0FB2, 0xD730, 0x6F51,
+        0xE5B8, 0x5DD9, 0x855B, 0x3D3A, 0x247E, 0x9C1F, 0x449D, 0xFCFC,
+        0x416E, 0xF90F, 0x218D, 0x99EC, 0x80A8, 0x38C9, 0xE04B, 0x582A,
+        0xD2C3, 0x6AA2, 0xB220, 0x0A41, 0x1305, 0xAB64, 0x73E6, 0xCB87,
+        0x18E3, 0xA082, 0x7800, 0xC061, 0xD925, 0x6144, 0xB9C6, 0x01A7,
+        0x8B4E, 0x332F, 0xEBAD, 0x53CC, 0x4A88, 0xF2E9, 0x2A6B, 0x920A,
+        0x2F98, 0x97F9, 0x4F7B, 0xF71A, 0xEE5E, 0x563F, 0x8EBD, 0x36DC,
+        0xBC35, 0x0454, 0xDCD6, 0x64B7, 0x7DF3, 0xC592, 0x1D10, 0xA571,
+    },
+    {
+        0x0000, 0x47D3, 0x8FA6, 0xC875, 0x0F6D, 0x48BE, 0x80CB, 0xC718,
+        0x1EDA, 0x5909, 0x917C, 0xD6AF, 0x11B7, 0x5664, 0x9E11, 0xD9C2,
+        0x3DB4, 0x7A67, 0xB212, 0xF5C1, 0x32D9, 0x750A, 0xBD7F, 0xFAAC,
+        0x236E, 0x64BD, 0xACC8, 0xEB1B, 0x2C03, 0x6BD0, 0xA3A5, 0xE476,
+        0x7B68, 0x3CBB, 0xF4CE, 0xB31D, 0x7405, 0x33D6, 0xFBA3, 0xBC70,
+        0x65B2, 0x2261, 0xEA14, 0xADC7, 0x6ADF, 0x2D0C, 0xE579, 0xA2AA,
+        0x46DC, 0x010F, 0xC97A, 0x8EA9, 0x49B1, 0x0E62, 0xC617, 0x81C4,
+        0x5806, 0x1FD5, 0xD7A0, 0x9073, 0x576B, 0x10B8, 0xD8CD, 0x9F1E,
+        0xF6D0, 0xB103, 0x7976, 0x3EA5, 0xF9BD, 0xBE6E, 0x761B, 0x31C8,
+        0xE80A, 0xAFD9, 0x67AC, 0x207F, 0xE767, 0xA0B4, 0x68C1, 0x2F12,
+        0xCB64, 0x8CB7, 0x44C2, 0x0311, 0xC409, 0x83DA, 0x4BAF, 0x0C7C,
+        0xD5BE, 0x926D, 0x5A18, 0x1DCB, 0xDAD3, 0x9D00, 0x5575, 0x12A6,
+        0x8DB8, 0xCA6B, 0x021E, 0x45CD, 0x82D5, 0xC506, 0x0D73, 0x4AA0,
+        0x9362, 0xD4B1, 0x1CC4, 0x5B17, 0x9C0F, 0xDBDC, 0x13A9, 0x547A,
+        0xB00C, 0xF7DF, 0x3FAA, 0x7879, 0xBF61, 0xF8B2, 0x30C7, 0x7714,
+        0xAED6, 0xE905, 0x2170, 0x66A3, 0xA1BB, 0xE668, 0x2E1D, 0x69CE,
+        0xFD81, 0xBA52, 0x7227, 0x35F4, 0xF2EC, 0xB53F, 0x7D4A, 0x3A99,
+        0xE35B, 0xA488, 0x6CFD, 0x2B2E, 0xEC36, 0xABE5, 0x6390, 0x2443,
+        0xC035, 0x87E6, 0x4F93, 0x0840, 0xCF58, 0x888B, 0x40FE, 0x072D,
+        0xDEEF, 0x993C, 0x5149, 0x169A, 0xD182, 0x9651, 0x5E24, 0x19F7,
+        0x86E9, 0xC13A, 0x094F, 0x4E9C, 0x8984, 0xCE57, 0x0622, 0x41F1,
+        0x9833, 0xDFE0, 0x1795, 0x5046, 0x975E, 0xD08D, 0x18F8, 0x5F2B,
+        0xBB5D, 0xFC8E, 0x34FB, 0x7328, 0xB430, 0xF3E3, 0x3B96, 0x7C45,
+        0xA587, 0xE254, 0x2A21, 0x6DF2, 0xAAEA, 0xED39, 0x254C, 0x629F,
+        0x0B51, 0x4C82, 0x84F7, 0xC324, 0x043C, 0x43EF, 0x8B9A, 0xCC49,
+        0x158B, 0x5258, 0x9A2D, 0xDDFE, 0x1AE6, 0x5D35, 0x9540, 0xD293,
+        0x36E5, 0x7136, 0xB943, 0xFE90, 0x3988, 0x7E5B, 0xB62E, 0xF1FD,
+        0x283F, 0x6FEC, 0xA799, 0xE04A, 0x2752, 0x6081, 0xA8F4, 0xEF27,
+        0x7039, 0x37EA, 0xFF9F, 0xB84C, 0x7F54, 0x3887, 0xF0F2, 0xB721,
+        0x6EE3, 0x2930, 0xE145, 0xA696, 0x618E, 0x265D, 0xEE28, 0xA9FB,
+        0x4D8D, 0x0A5E, 0xC22B, 0x85F8, 0x42E0, 0x0533, 0xCD46, 0x8A95,
+        0x5357, 0x1484, 0xDCF1, 0x9B22, 0x5C3A, 0x1BE9, 0xD39C, 0x944F,
+    },
 };
 //---------------------------------------------------------------------
 
@@ -82,13 +550,57 @@ tAESYS_MEP_CODE_PROPERTIES records[] =
 /// \brief Private functions declarations.
 ///
 static uint8_t isValidCommand(uint8_t cmd);
-static void calculateCRCByte(uint8_t byte, uint16_t *crc);
-static uint16_t cpydataToSendFrame(uint8_t *src, uint8_t *dst, uint16_t size, uint16_t *crc);
+static uint16_t calculateCRC(const uint8_t *data, uint32_t size, uint16_t crc);
+static uint16_t calculateCRCTable(const uint8_t *data, uint32_t size, uint16_t crc);
+static uint16_t findEscapeByte(const uint8_t *src, uint16_t size, const uint8_t set[3]);
 static void  swapStrBytes(uint8_t *src, uint32_t src_size, uint8_t element_size, uint32_t count);
-static uint8_t encodeToUPTBFrame(uint8_t tx_bytes, uint8_t *buffer, uint16_t b_size, tAESYS_MEP_BUFFER *frame);
-static int addTextProperties(uint8_t *buffer, uint16_t *offset, const tAESYS_MEP_MSG_DATA *msg, const tAESYS_MEP_PANEL_DATA *panel);
+static uint8_t encodeToUPTBFrame(const uint8_t *src, uint16_t size, uint8_t *dst, uint16_t dst_size, uint16_t *offset, uint16_t *crc);
+static uint8_t escapeWord(uint16_t value, uint8_t *dst);
+static uint16_t escapedPosition(const tAESYS_MEP_FRAME_TEMPLATE *tmpl, uint16_t raw);
+static int addTextProperties(uint8_t *buffer, uint16_t *offset, const tAESYS_MEP_MSG_DATA *msg, const tAESYS_MEP_PANEL_DATA *panel, tAESYS_MEP_TEXT_SPAN *spans);
+static uint8_t writeHexPosition(uint8_t *dst, uint16_t value);
 static uint8_t decodeData(const uint8_t *src, uint8_t *dest, uint16_t src_size, uint16_t dest_size, uint16_t *offset, uint16_t *crc);
-static tAESYS_MEP_BUFFER * createSendMEPFrame(uint8_t type, uint16_t addrs, uint16_t dlen, uint16_t trans, uint8_t cmd, uint8_t *data);
+static char setOutputSize(const tAESYS_MEP_OUTPUT *output, uint16_t *b_size);
+static uint8_t * decodeUPTBFrame(const uint8_t *frame, uint16_t frame_size, uint8_t *inplace);
+static uint8_t appendToDeframer(tAESYS_MEP_UPTB_DEFRAMER *deframer, const uint8_t *src, uint16_t size);
+static uint8_t responseType(uint16_t code, uint16_t length);
+static tAESYS_MEP_RESPONSE * parseResponse(const tAESYS_MEP_PPTP_VIEW *pptp, uint8_t arena);
+static char viewResponse(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_PPTP_VIEW *view);
+static char decodeGroup(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, const tAESYS_MEP_GROUP *group, void *info, uint16_t info_size);
+static char indexValue(const tAESYS_MEP_RESPONSE_INDEX *index, uint16_t code, uint8_t type1, uint8_t type2, uint16_t length, const uint8_t **data, uint16_t *size);
+static tAESYS_MEP_RESPONSE * parseMEPFrame(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, uint8_t arena);
+static tAESYS_MEP_BUFFER * createSendMEPFrame(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t addrs, uint16_t dlen, uint16_t trans, uint8_t cmd, uint8_t *data);
+static tAESYS_MEP_BUFFER * buildClockInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id);
+static tAESYS_MEP_BUFFER * buildDeviceInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id);
+static tAESYS_MEP_BUFFER * buildDevStatusInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id);
+static tAESYS_MEP_BUFFER * buildDiagnosticInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id);
+static tAESYS_MEP_BUFFER * buildDevRestartedInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id);
+static tAESYS_MEP_BUFFER * buildLastPublicationInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id);
+static tAESYS_MEP_BUFFER * buildTempInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t code);
+static tAESYS_MEP_BUFFER * buildHumidityInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t code);
+static tAESYS_MEP_BUFFER * buildBrightnessInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t code);
+static tAESYS_MEP_BUFFER * buildTrafficLightInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t code);
+static tAESYS_MEP_BUFFER * buildEnvBrightnessInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t code);
+static tAESYS_MEP_BUFFER * buildNextGetMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t sentinel, const tAESYS_MEP_GET_CMD *cmds, uint16_t count, uint16_t *offset);
+static tAESYS_MEP_BUFFER * buildClearPublication(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id);
+static tAESYS_MEP_BUFFER * buildResetDeviceMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id);
+static tAESYS_MEP_BUFFER * buildDelCode(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t code);
+static tAESYS_MEP_BUFFER * buildSetMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t sentinel, const tAESYS_MEP_SET_CMD *cmds, uint16_t count);
+static tAESYS_MEP_BUFFER * buildClockMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint8_t *clock);
+static tAESYS_MEP_BUFFER * buildBrightnessMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t values[]);
+static tAESYS_MEP_BUFFER * buildLastPublicationStatusMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint8_t status);
+static tAESYS_MEP_BUFFER * buildDeviceIdMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t size, const char *strId);
+static tAESYS_MEP_BUFFER * buildDeviceDescMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t size, const char *desc);
+static tAESYS_MEP_BUFFER * buildTrafficLightStatusMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t code, uint16_t value);
+static tAESYS_MEP_BUFFER * buildPictogramMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint8_t flashing_lamps, uint16_t picto_code);
+static tAESYS_MEP_BUFFER * buildTextMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint8_t size, const tAESYS_MEP_MSG_DATA *msg, const tAESYS_MEP_PANEL_DATA *panel, tAESYS_MEP_TEXT_SPAN *spans);
+static tAESYS_MEP_BUFFER * buildPublicationMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t id, uint8_t size, const tAESYS_MEP_PUB_PAGE *pages, const tAESYS_MEP_PANEL_DATA *panel);
+static tAESYS_MEP_BUFFER * bulkWriteNext(tAESYS_MEP_OUTPUT *output, tAESYS_MEP_BULK_WRITE *bulk, uint8_t type, uint16_t trans_id);
+static tAESYS_MEP_BUFFER * bulkReadNext(tAESYS_MEP_OUTPUT *output, tAESYS_MEP_BULK_READ *bulk, uint8_t type, uint16_t trans_id);
+#ifdef AESYS_MEP_GZIP
+static char inflatePayload(tAESYS_MEP_PPTP_VIEW *view, uint8_t *dst, uint16_t d_size);
+static tAESYS_MEP_BUFFER * buildGzipMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint8_t *mep_frame, uint16_t mep_frame_size);
+#endif
 //---------------------------------------------------------------------
 /**********************************************************************
 *****                      PRIVATE FUNCTIONS                      *****
@@ -117,6 +629,10 @@ void swapStrBytes(uint8_t *src, uint32_t src_size, uint8_t element_size, uint32_
 
 uint8_t isValidCommand(uint8_t cmd)
 {
+#ifdef AESYS_MEP_GZIP
+   cmd &= ~K_MEP_GZIP_CMD;
+#endif
+
    for (int iEnum = MEP_SET; iEnum != (MEP_DAT+1); iEnum++)
         if (cmd == iEnum)
             return 1;
@@ -125,326 +641,257 @@ uint8_t isValidCommand(uint8_t cmd)
 }
 //---------------------------------------------------------------------
 
-void calculateCRCByte(uint8_t byte, uint16_t *crc)
+#ifdef AESYS_MEP_X86_64
+
+static uint8_t cpuFeatures(void)
 {
-    *crc = *crc ^ ((uint16_t)byte << 8);
+    // The detection is done once. Concurrent first calls store the same value.
+    static int features = -1;
 
-    for (uint8_t j = 0; j < 8; j++)
+    if (features < 0)
     {
-         if (*crc & K_CRC_MASK)
-             *crc = (*crc << 1) ^ K_POLYGEN;
-         else
-             *crc <<= 1;
-    }
-}
-//---------------------------------------------------------------------
+        int value = 0;
+        unsigned int regs[4] = {0};
 
-uint16_t cpydataToSendFrame(uint8_t *src, uint8_t *dst, uint16_t size, uint16_t *crc)
-{
-    uint16_t i = 0;
+        #if defined(_MSC_VER)
+            __cpuid((int *) regs,1);
+        #else
+            __get_cpuid(1,&regs[0],&regs[1],&regs[2],&regs[3]);
+        #endif
 
-    for (; i < size; i++)
-    {
-         if (crc != NULL)
-             calculateCRCByte(src[i],crc);
+        // ECX bit 1: PCLMULQDQ. ECX bit 9: SSSE3.
+        if ((regs[2] & 0x00000202) == 0x00000202)
+            value |= K_CPU_CLMUL;
+
+        // ECX bit 27: OSXSAVE, bit 28: AVX. The OS must save the YMM registers.
+        if ((regs[2] & 0x18000000) == 0x18000000)
+        {
+            unsigned int xcr0;
+
+            #if defined(_MSC_VER)
+                xcr0 = (unsigned int) _xgetbv(0);
+                __cpuidex((int *) regs,7,0);
+            #else
+                __asm__ ("xgetbv" : "=a" (xcr0) : "c" (0) : "edx");
+                __cpuid_count(7,0,regs[0],regs[1],regs[2],regs[3]);
+            #endif
+
+            // XCR0 bits 1 and 2: SSE and AVX state. EBX bit 5: AVX2.
+            if ((xcr0 & 0x06) == 0x06 && (regs[1] & 0x00000020))
+                value |= K_CPU_AVX2;
+        }
 
-         dst[i] = src[i];
+        features = value;
     }
 
-    return i;
+    return (uint8_t) features;
 }
 //---------------------------------------------------------------------
 
-uint8_t decodeData(const uint8_t *src, uint8_t *dest, uint16_t src_size,
-                   uint16_t dest_size, uint16_t *offset, uint16_t *crc)
+MEP_TARGET("pclmul,ssse3")
+static __m128i foldCRCBlock(__m128i block, __m128i next, __m128i k)
 {
-    uint16_t i = 0, j = 0;
-
-    for (; j < dest_size && src[i] != K_MEP_ETX && i < src_size; i++)
-    {
-         if (src[i] == K_MEP_DLE)
-         {
-             if (i+1 == src_size)
-                 return 0;
-             if (src[i+1] == K_DSTX || src[i+1] == K_DETX || src[i+1] == K_DDLE)
-             {
-                 dest[j++] = src[++i] - K_DINC;
-                 if (crc != NULL)
-                     calculateCRCByte(dest[j-1],crc);
-             }
-             else
-                 return 0;
-         }
-         else
-         {
-             dest[j++] = src[i];
-             if (crc != NULL)
-                 calculateCRCByte(src[i],crc);
-         }
-    }
-
-    *offset += i;
-
-    return (j == dest_size);
+    return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(block,k,0x11),
+                                       _mm_clmulepi64_si128(block,k,0x00)),next);
 }
 //---------------------------------------------------------------------
 
-uint8_t encodeToUPTBFrame(uint8_t tx_bytes, uint8_t *buffer, uint16_t b_size, tAESYS_MEP_BUFFER *frame)
+MEP_TARGET("pclmul,ssse3")
+static uint16_t calculateCRCClmul(const uint8_t *data, uint32_t size, uint16_t crc)
 {
-    uint8_t plus;
-    uint16_t j = ((tx_bytes) ? 1 : 0);
-    uint16_t size = 0, newElements = 0;
+    // The blocks are loaded as big endian 128 bits polynomials. Each block is
+    // folded over the next ones multiplying by x^D mod P. At the end the
+    // remaining 128 bits have the same CRC than the folded data and the
+    // table engine finish the last block plus the tail (< 16 bytes).
+    uint8_t  last[16];
+    __m128i  x0, x1, x2, x3;
+    const __m128i swap = _mm_set_epi8(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15);
+    const __m128i k128 = _mm_set_epi64x(K_CRC_FOLD_192,K_CRC_FOLD_128);
+    const __m128i k512 = _mm_set_epi64x(K_CRC_FOLD_576,K_CRC_FOLD_512);
+
+    #define LOADBLOCK(i) _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) &data[i]),swap)
+
+    x0 = _mm_xor_si128(LOADBLOCK(0),_mm_set_epi64x((int64_t)((uint64_t) crc << 48),0));
+    x1 = LOADBLOCK(16);
+    x2 = LOADBLOCK(32);
+    x3 = LOADBLOCK(48);
+
+    // Fold 4 blocks in parallel (64 bytes per iteration).
+    for (data += 64, size -= 64; size >= 64; data += 64, size -= 64)
+    {
+         x0 = foldCRCBlock(x0,LOADBLOCK(0) ,k512);
+         x1 = foldCRCBlock(x1,LOADBLOCK(16),k512);
+         x2 = foldCRCBlock(x2,LOADBLOCK(32),k512);
+         x3 = foldCRCBlock(x3,LOADBLOCK(48),k512);
+    }
 
-    if (buffer == NULL || frame == NULL || frame->data != NULL || b_size > K_MEP_MAX_FRAME_SIZE)
-        return 0;
+    // Reduce to 1 block and fold the remaining 16 bytes blocks.
+    x0 = foldCRCBlock(x0,x1,k128);
+    x0 = foldCRCBlock(x0,x2,k128);
+    x0 = foldCRCBlock(x0,x3,k128);
 
-    // Check the num of elements to encode.
-    for (uint16_t i = 0; i < b_size; i++)
-         if (buffer[i] == K_MEP_STX || buffer[i] == K_MEP_ETX || buffer[i] == K_MEP_DLE)
-             newElements++;
+    for (; size >= 16; data += 16, size -= 16)
+         x0 = foldCRCBlock(x0,LOADBLOCK(0),k128);
 
-    // Check the final frame size.
-    size = b_size + newElements;
-    if (size > K_MEP_MAX_FRAME_SIZE)
-        return 0;
+    #undef LOADBLOCK
 
-    frame->size  = size+tx_bytes;
-    frame->data = (uint8_t *) calloc(frame->size,sizeof(uint8_t));
-    if (frame->data == NULL)
-        return 0;
+    _mm_storeu_si128((__m128i *) last,_mm_shuffle_epi8(x0,swap));
+    crc = calculateCRCTable(last,sizeof(last),0);
 
-    for (uint16_t i = 0; i < b_size; i++, j++)
-    {
-        plus = 0;
-        if (buffer[i] == K_MEP_STX || buffer[i] == K_MEP_ETX || buffer[i] == K_MEP_DLE)
-        {
-            frame->data[j] = K_MEP_DLE;
-            plus = K_DINC;
-            j++;
-        }
+    return calculateCRCTable(data,size,crc);
+}
+//---------------------------------------------------------------------
 
-        frame->data[j] = buffer[i] + plus;
-    }
+static uint16_t findEscapeByteSSE2(const uint8_t *src, uint16_t size, const uint8_t set[3])
+{
+    uint16_t i = 0;
+    unsigned int mask;
+    const __m128i b0 = _mm_set1_epi8((char) set[0]);
+    const __m128i b1 = _mm_set1_epi8((char) set[1]);
+    const __m128i b2 = _mm_set1_epi8((char) set[2]);
 
-    // Check if add the TX bytes: STX and ETX
-    if (tx_bytes)
+    for (; i+16 <= size; i += 16)
     {
-        frame->data[0] = K_MEP_STX;
-        frame->data[j] = K_MEP_ETX;
+         __m128i v = _mm_loadu_si128((const __m128i *) &src[i]);
+         mask = (unsigned int) _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v,b0),
+                                                                           _mm_cmpeq_epi8(v,b1)),
+                                                              _mm_cmpeq_epi8(v,b2)));
+         if (mask)
+             return i + MEP_CTZ(mask);
     }
 
-    return 1;
+    for (; i < size; i++)
+         if (src[i] == set[0] || src[i] == set[1] || src[i] == set[2])
+             break;
+
+    return i;
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * createSendMEPFrame(uint8_t type, uint16_t addrs, uint16_t dlen, uint16_t trans, uint8_t cmd, uint8_t *data)
+MEP_TARGET("avx2")
+static uint16_t findEscapeByteAVX2(const uint8_t *src, uint16_t size, const uint8_t set[3])
 {
-    tAESYS_MEP_UPTB_FRAME uptbFrame = { .crc = 0, .addr = htons(addrs), .pptp.dlen = htons(dlen), .pptp.tran = htons(trans), .pptp.cmd = cmd, };
-    uint16_t offset  = 0, headSize  = 5   , crc = 0xFFFF, *crcPtr = NULL, frameSize = headSize + dlen;
-    uint8_t  txBytes = 0, *tBuffer  = NULL, *ptrFrame = (uint8_t *) &uptbFrame.pptp;
-    tAESYS_MEP_BUFFER *frame  = NULL;
+    uint16_t i = 0;
+    unsigned int mask;
+    const __m256i b0 = _mm256_set1_epi8((char) set[0]);
+    const __m256i b1 = _mm256_set1_epi8((char) set[1]);
+    const __m256i b2 = _mm256_set1_epi8((char) set[2]);
 
-    if (type)
+    for (; i+32 <= size; i += 32)
     {
-        frameSize += 4;
-        headSize  += 2;
-        ptrFrame   = (uint8_t *) &uptbFrame;
-        ptrFrame  += 2;
-        crcPtr     = &crc;
-        txBytes    = (type == MEP_UPTBNTX) ? 0 : 2;
+         __m256i v = _mm256_loadu_si256((const __m256i *) &src[i]);
+         mask = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v,b0),
+                                                                                    _mm256_cmpeq_epi8(v,b1)),
+                                                                    _mm256_cmpeq_epi8(v,b2)));
+         if (mask)
+             return i + MEP_CTZ(mask);
     }
 
-    if (frameSize > K_MEP_MAX_FRAME_SIZE || dlen > K_MEP_MAX_DATA_SIZE || type > 2)
-        goto CSFRAME_ERROR;
-
-    tBuffer = (uint8_t *) calloc(frameSize,sizeof(uint8_t));
-    if (tBuffer == NULL)
-        goto CSFRAME_ERROR;
-
-    frame   = (tAESYS_MEP_BUFFER *) calloc(1,sizeof(tAESYS_MEP_BUFFER));
-    if (frame == NULL)
-        goto CSFRAME_ERROR;
-
-    offset += cpydataToSendFrame(ptrFrame,&tBuffer[offset],headSize,crcPtr);
-    offset += cpydataToSendFrame(data,&tBuffer[offset],dlen,crcPtr);
-
-    switch (type)
-    {
-        case  MEP_PPTP:
-            frame->size = frameSize;
-            frame->data = tBuffer;
-        break;
-        case MEP_UPTB:
-        case MEP_UPTBNTX:
-            crc = htons(crc);
-            memcpy(&tBuffer[offset],&crc,2);
-            if (encodeToUPTBFrame(txBytes,tBuffer,frameSize,frame) == 0)
-                goto CSFRAME_ERROR;
+    // Avoid the AVX-SSE transition penalty in the legacy SSE code.
+    _mm256_zeroupper();
 
-            free(tBuffer);
-        break;
-    }
+    return i + findEscapeByteSSE2(&src[i],size-i,set);
+}
+//---------------------------------------------------------------------
 
-    return frame;
+#endif
 
-    CSFRAME_ERROR:
+uint16_t findEscapeByte(const uint8_t *src, uint16_t size, const uint8_t set[3])
+{
+    #ifdef AESYS_MEP_X86_64
+        if (cpuFeatures() & K_CPU_AVX2)
+            return findEscapeByteAVX2(src,size,set);
 
-    if (tBuffer != NULL)
-        free(tBuffer);
+        return findEscapeByteSSE2(src,size,set);
+    #else
+        uint16_t i = 0;
 
-    if (frame != NULL) {
-        if (frame->data != NULL)
-            free(frame->data);
-        free(frame);
-    }
+        for (; i < size; i++)
+             if (src[i] == set[0] || src[i] == set[1] || src[i] == set[2])
+                 break;
 
-    return frame;
+        return i;
+    #endif
 }
 //---------------------------------------------------------------------
 
-int addTextProperties(uint8_t *buffer, uint16_t *offset, const tAESYS_MEP_MSG_DATA *msg, const tAESYS_MEP_PANEL_DATA *panel)
+uint16_t calculateCRC(const uint8_t *data, uint32_t size, uint16_t crc)
 {
-    char vat[4];
-    char hat[4];
-    char aux[10];
-    uint16_t size;
-    uint16_t lpdh, lpdv;
-    uint16_t rows, cols;
-    uint16_t vAlign, hAlign;
-    int page_size = *offset;
-    uint8_t  rowSpacing, colSpacing;
-
-    #define APPENDV(cmd,nv,v1,v2,v3,v4) \
-    {\
-        if (nv == 0) \
-            sprintf(aux,"%s",cmd); \
-        if (nv == 1) \
-            sprintf(aux,"%s%c",cmd,v1);   \
-        if (nv == 2) \
-            sprintf(aux,"%s%c%c",cmd,v1,v2); \
-        if (nv == 3) \
-            sprintf(aux,"%s%s",cmd,v3);   \
-        if (nv == 4) \
-            sprintf(aux,"%s%s%s",cmd,v3,v4); \
-        \
-        size = strlen(aux);  \
-        if (((*offset) + size) > K_MEP_MAX_DATA_SIZE) \
-             return -1; \
-        \
-        memcpy(&buffer[*offset],aux,size); \
-        *offset += size; \
-    }\
+    #ifdef AESYS_MEP_X86_64
+        if (size >= K_CRC_CLMUL_MIN && (cpuFeatures() & K_CPU_CLMUL))
+            return calculateCRCClmul(data,size,crc);
+    #endif
 
-    // ### CONSTRUCT THE DRAWING COMMANDS ###
-    // Blinking text
-    if (msg->blinking_text == 1)
-        APPENDV("\x17\x41",0,0,0,"","");
-
-    // Antialiasing
-    if (msg->antialiasing > 0 && msg->antialiasing <= 9)
-        APPENDV("\x17\x42",1,msg->antialiasing+48,0,"","");
-
-    // Get the vertical leds used by each letter
-    // and calculate the max number of rows supported by the device.
-    rowSpacing = (msg->row_spacing > 9 || msg->total_rows == 1) ? 0 : msg->row_spacing;
-    lpdv = panel->font_size[1]+rowSpacing;
+    return calculateCRCTable(data,size,crc);
+}
+//---------------------------------------------------------------------
 
-    if (msg->truncate)
+uint16_t calculateCRCTable(const uint8_t *data, uint32_t size, uint16_t crc)
+{
+    // Slicing-by-8. Process 8 bytes per iteration with independent lookups.
+    for (; size >= 8; size -= 8, data += 8)
     {
-        rows = (panel->panel_size[1]+rowSpacing)/lpdv;
-        if (rows == 0 || msg->total_rows < rows)
-            rows = msg->total_rows;
+         crc = crc_table[7][(crc >> 8) ^ data[0]] ^ crc_table[6][(crc & 0xFF) ^ data[1]] ^
+               crc_table[5][data[2]] ^ crc_table[4][data[3]] ^ crc_table[3][data[4]] ^
+               crc_table[2][data[5]] ^ crc_table[1][data[6]] ^ crc_table[0][data[7]];
     }
-    else
-        rows = msg->total_rows;
-
-    // Calculate the vertical alignment for the first element.
-    vAlign = panel->panel_size[1] - ((lpdv * rows) - rowSpacing);        // Bottom.
-
-    if (vAlign > panel->panel_size[1] || !msg->v_alignment) vAlign  = 0;  // Top or invalid value.
-    else if (msg->v_alignment == 1)                         vAlign /= 2;  // Center.
 
-    for (uint16_t r = 0; r < rows; r++)
+    // Slicing-by-4 for the remaining bytes if possible.
+    if (size >= 4)
     {
-         // Get the horizontal leds used by each letter
-         // and calculate the aprox max number of cols supported by the device.
-         colSpacing = (msg->rows[r].col_spacing > 9 ) ? 0 : msg->rows[r].col_spacing;
-         lpdh = panel->font_size[0]+colSpacing;
-         if (msg->truncate && !msg->rows[r].compact_font)
-         {
-             cols = (panel->panel_size[0]+colSpacing)/lpdh;
-             if (cols == 0 || msg->rows[r].msg_size < cols)
-                 cols = msg->rows[r].msg_size;
-         }
-         else
-             cols = msg->rows[r].msg_size;
-
-         // Calculate the horizontal alignment. If compactfont is true,
-         // then disable horizontal aligment because the size of each letter is variable.
-         hAlign = panel->panel_size[0] - ((lpdh * cols) - colSpacing);               // Right.
-
-         if (hAlign > panel->panel_size[0] || !msg->rows[r].h_alignment || msg->rows[r].compact_font)  // Left, invalid value or compactFont is set.
-             hAlign  = 0;
-         else if (msg->rows[r].h_alignment == 1)                                                       // Center.
-             hAlign /= 2;
-
-         // Vertical and Horizontal alignment as hex value.
-         sprintf(vat,"%.3X",vAlign);
-         sprintf(hat,"%.3X",hAlign);
-
-         // Basic color or RGBY color
-         if (msg->rows[r].custom_colors[0] && msg->rows[r].custom_colors[0] <= 5) {
-             APPENDV("\x17\x43",1,msg->rows[r].custom_colors[0]+47,0,"","");
-         }
-         else if (msg->rows[r].custom_colors[0] == 6 && isxdigit(msg->rows[r].custom_colors[1])      &&
-                  isxdigit(msg->rows[r].custom_colors[2]) && isxdigit(msg->rows[r].custom_colors[3]) &&
-                  isxdigit(msg->rows[r].custom_colors[4])) {
-             APPENDV("\x17\x44",3,0,0,&msg->rows[r].custom_colors[1],"");
-         }
+        crc = crc_table[3][(crc >> 8) ^ data[0]] ^ crc_table[2][(crc & 0xFF) ^ data[1]] ^
+              crc_table[1][data[2]] ^ crc_table[0][data[3]];
+        size -= 4;
+        data += 4;
+    }
 
-         // Scrolling
-         if (msg->rows[r].scrolling_speed >= 1 && msg->rows[r].scrolling_speed <= 9)
-             APPENDV("\x17\x53\x48",1,msg->rows[r].scrolling_speed+48,0,"","");
+    for (; size > 0; size--, data++)
+         crc = (crc << 8) ^ crc_table[0][(crc >> 8) ^ *data];
 
-         // Set Position, font, col & row Spacing
-         APPENDV("\x17\x51",4,0,0,vat,hat);
-         APPENDV("\x17\x46\x31",2,colSpacing+48,rowSpacing+48,"","");
+    return crc;
+}
+//---------------------------------------------------------------------
 
-         if (msg->rows[r].compact_font)
-             APPENDV("\x17\x4F",0,0,0,"","");
+uint8_t decodeData(const uint8_t *src, uint8_t *dest, uint16_t src_size,
+                   uint16_t dest_size, uint16_t *offset, uint16_t *crc)
+{
+    uint16_t i = 0, j = 0, run;
+    const uint8_t stops[3] = {K_MEP_ETX,K_MEP_DLE,K_MEP_DLE};
 
-         if (((*offset)+cols) > K_MEP_MAX_DATA_SIZE)
-             return -1;
+    while (j < dest_size && i < src_size)
+    {
+         // Copy the run until the next ETX or DLE byte. dest can overlap src when decode in place.
+         run = ((src_size-i < dest_size-j) ? src_size-i : dest_size-j);
+         run = findEscapeByte(&src[i],run,stops);
+         memmove(&dest[j],&src[i],run);
+         i += run;
+         j += run;
+
+         if (j == dest_size || i == src_size || src[i] == K_MEP_ETX)
+             break;
 
-         memcpy(&buffer[*offset],msg->rows[r].msg,cols);
-         *offset += cols;
-         vAlign  += lpdv;
+         // DLE: the next byte must be an escaped STX, ETX or DLE.
+         if (i+1 == src_size)
+             return 0;
+         if (src[i+1] == K_DSTX || src[i+1] == K_DETX || src[i+1] == K_DDLE)
+             dest[j++] = src[i+1] - K_DINC;
+         else
+             return 0;
+         i += 2;
     }
 
-    return ((*offset)-page_size);
-}
-
-//---------------------------------------------------------------------
-/**********************************************************************
-*****                       PUBLIC FUNCTIONS                      *****
-*****                        Decode section                       *****
-**********************************************************************/
-
-const tAESYS_MEP_CODE_PROPERTIES * AesysMepGetCodeProperties(uint16_t code)
-{
-    uint16_t size = sizeof (records)/sizeof(tAESYS_MEP_CODE_PROPERTIES);
+    if (crc != NULL)
+        *crc = calculateCRC(dest,j,*crc);
 
-    for (uint16_t i = 0; i < size; i++)
-         if (code == records[i].code)
-             return &records[i];
+    *offset += i;
 
-    return NULL;
+    return (j == dest_size);
 }
 //---------------------------------------------------------------------
 
-uint8_t * AesysMepDecodeUPTBFrame(const uint8_t *frame, uint16_t frame_size)
+uint8_t * decodeUPTBFrame(const uint8_t *frame, uint16_t frame_size, uint8_t *inplace)
 {
-    uint8_t buffer[7], *decoded = NULL;
+    uint8_t buffer[9], *decoded = NULL, *data = inplace;
     uint16_t crc, size = 0, offset = 1, compute_crc = 0xFFFF;
 
     // Check frame data. Not null and have STX and ETX bytes.
@@ -466,19 +913,22 @@ uint8_t * AesysMepDecodeUPTBFrame(const uint8_t *frame, uint16_t frame_size)
     if (size > K_MEP_MAX_DATA_SIZE)
         goto DEC_ERROR;
 
-    // Prepare memory for decoded frame. CRC,ADDR,DLEN,TRANS,CMD,DATA
-    decoded = (uint8_t *) calloc(size+9,sizeof (uint8_t));
-    if (decoded == NULL)
-        goto DEC_ERROR;
+    // Prepare memory for decoded frame. CRC,ADDR,DLEN,TRANS,CMD,DATA. In place the data
+    // is decoded at the start of the frame, it never overwrites bytes not decoded yet.
+    if (inplace == NULL)
+    {
+        decoded = (uint8_t *) calloc(size+9,sizeof (uint8_t));
+        if (decoded == NULL)
+            goto DEC_ERROR;
 
-    // Copy UoPTB header and decode data from frame
-    memcpy(&decoded[2],buffer,7);
+        data = &decoded[9];
+    }
 
-    if (!decodeData(&frame[offset],&decoded[9],frame_size-offset,size,&offset,&compute_crc))
+    if (!decodeData(&frame[offset],data,frame_size-offset,size,&offset,&compute_crc))
         goto DEC_ERROR;
 
     // Decode the CRC
-    if (!decodeData(&frame[offset],buffer,frame_size-offset,2,&offset,NULL))
+    if (!decodeData(&frame[offset],&buffer[7],frame_size-offset,2,&offset,NULL))
         goto DEC_ERROR;
 
     // Check if the length is valid. Plus 1 that represents the ETX byte.
@@ -486,201 +936,383 @@ uint8_t * AesysMepDecodeUPTBFrame(const uint8_t *frame, uint16_t frame_size)
         goto DEC_ERROR;
 
     // Validate the CRC.
-    offset = 0;
+    offset = 7;
     GETVAL16(crc,buffer,offset);
     if (crc != compute_crc)
         goto DEC_ERROR;
 
-    // Copy CRC
+    // In place the decoded frame starts at an even address and the data is moved
+    // after the header. The escaped frame have at least 2 bytes more than needed.
+    if (inplace != NULL)
+    {
+        decoded = inplace + ((uintptr_t) inplace & 1);
+        memmove(&decoded[9],data,size);
+    }
+
+    // Copy UoPTB header and CRC
+    memcpy(&decoded[2],buffer,7);
     memcpy(&decoded[0],&crc,2);
 
     return decoded;
 
     DEC_ERROR:
 
-    if (decoded != NULL)
+    if (inplace == NULL && decoded != NULL)
         free(decoded);
 
     return NULL;
 }
 //---------------------------------------------------------------------
 
-uint8_t * AesysMepCncopyPPTPFrame(const uint8_t *frame, uint16_t frame_size)
+uint8_t appendToDeframer(tAESYS_MEP_UPTB_DEFRAMER *deframer, const uint8_t *src, uint16_t size)
 {
-    uint16_t size, offset = 0;
-    uint8_t *duplicate = NULL;
+    uint16_t count, limit, crcLimit;
+    uint8_t *frame = &deframer->frame[2];
 
-    if (frame != NULL && frame_size >= K_MEP_MIN_SIZE_PPTB)
+    while (size > 0)
     {
-        // Check if have a valid command
-        if (!isValidCommand(frame[4]))
-            return NULL;
-
-        // Check the data size is valid.
-        GETVAL16(size,frame,offset);
-        if (size > K_MEP_MAX_DATA_SIZE || size != frame_size-5)
-            return NULL;
+         // Until the header is complete the data size is unknown.
+         limit    = (deframer->size < K_UPTB_HEAD_SIZE) ? K_UPTB_HEAD_SIZE : K_UPTB_HEAD_SIZE + deframer->dlen + 2;
+         crcLimit = (deframer->size < K_UPTB_HEAD_SIZE) ? K_UPTB_HEAD_SIZE : K_UPTB_HEAD_SIZE + deframer->dlen;
+         if (deframer->size == limit)
+             return 0;
+
+         count = (size > limit-deframer->size) ? limit-deframer->size : size;
+         memcpy(&frame[deframer->size],src,count);
+
+         // The CRC bytes are not part of the CRC.
+         if (deframer->size < crcLimit)
+             deframer->crc = calculateCRC(&frame[deframer->size],
+                                          (count > crcLimit-deframer->size) ? crcLimit-deframer->size : count,
+                                          deframer->crc);
+
+         deframer->size += count;
+         src            += count;
+         size           -= count;
+
+         // Check the header: command and data frame length.
+         if (deframer->size == K_UPTB_HEAD_SIZE)
+         {
+             deframer->dlen = (frame[2] << 8) | frame[3];
+             if (!isValidCommand(frame[6]) || deframer->dlen > K_MEP_MAX_DATA_SIZE)
+                 return 0;
+         }
+    }
 
-        // Alloc memory for the new frame, copy and transform the header.
-        duplicate = (uint8_t *) calloc(frame_size,sizeof(uint8_t));
+    return 1;
+}
+//---------------------------------------------------------------------
 
-        if (duplicate != NULL)
-        {
-            memcpy(duplicate,frame,frame_size);
-            swapStrBytes(duplicate,frame_size,2,2);
-        }
+uint8_t encodeToUPTBFrame(const uint8_t *src, uint16_t size, uint8_t *dst, uint16_t dst_size, uint16_t *offset, uint16_t *crc)
+{
+    uint16_t i = 0, j = *offset, run, block;
+    const uint8_t escapes[3] = {K_MEP_STX,K_MEP_ETX,K_MEP_DLE};
+
+    // When dst is full the encoding continues without writing for know the required size.
+    while (i < size)
+    {
+         // Update the CRC block by block while the data is still in cache.
+         block = ((size-i > K_ENC_BLOCK) ? K_ENC_BLOCK : size-i);
+         if (crc != NULL)
+             *crc = calculateCRC(&src[i],block,*crc);
+
+         // Copy the runs without escape bytes and escape the byte found at the end of each run.
+         for (block += i; i < block; i++)
+         {
+              run = findEscapeByte(&src[i],block-i,escapes);
+              if (run != 0 && j+run <= dst_size)
+                  memcpy(&dst[j],&src[i],run);
+
+              j += run;
+              i += run;
+
+              if (i == block)
+                  break;
+
+              if (j+2 <= dst_size)
+              {
+                  dst[j]   = K_MEP_DLE;
+                  dst[j+1] = src[i] + K_DINC;
+              }
+
+              j += 2;
+         }
     }
 
-    return duplicate;
+    *offset = j;
+
+    return (j <= dst_size);
 }
 //---------------------------------------------------------------------
 
-char AesysMepReadNextDelCMD(uint8_t *payload, uint16_t p_size, uint16_t *offset, uint16_t *code)
+uint8_t escapeWord(uint16_t value, uint8_t *dst)
 {
-    uint16_t size = sizeof(uint16_t);
+    uint8_t i, byte, size = 0;
 
-    if (payload == NULL || offset == NULL || code == NULL || p_size < size)
-        return -1;
-    if (*offset >= p_size)
-        return 0;
-    if ((*offset)+size > p_size)
+    // For the few bytes of a field the generic encoder only adds overhead.
+    for (i = 0; i < 2; i++)
+    {
+         byte = (i == 0) ? (value >> 8) : (value & 0xFF);
+
+         if (byte == K_MEP_STX || byte == K_MEP_ETX || byte == K_MEP_DLE)
+         {
+             dst[size++] = K_MEP_DLE;
+             byte += K_DINC;
+         }
+
+         dst[size++] = byte;
+    }
+
+    return size;
+}
+//---------------------------------------------------------------------
+
+char setOutputSize(const tAESYS_MEP_OUTPUT *output, uint16_t *b_size)
+{
+    if (b_size == NULL || output->result == -1)
         return -1;
 
-    GETVAL16(*code,payload,*offset);
+    *b_size = output->size;
 
-    return 1;
+    return output->result;
 }
 //---------------------------------------------------------------------
 
-char AesysMepReadNextSetCMD(uint8_t *payload, uint16_t p_size, uint16_t *offset, tAESYS_MEP_SET_CMD *cmd)
+uint8_t responseType(uint16_t code, uint16_t length)
 {
-    uint16_t size = sizeof(tAESYS_MEP_SET_CMD)-sizeof(uint8_t *);
+    const uint8_t unknown_types[] = {MEP_VOID,MEP_UINT8,MEP_UINT16,MEP_BINARY,MEP_UINT32};
+    const tAESYS_MEP_CODE_PROPERTIES *code_prop = AesysMepGetCodeProperties(code);
 
-    if (payload == NULL || offset == NULL || cmd == NULL || p_size < size)
+    // The codes not supported by this library use a type according to the size.
+    if (code_prop != NULL)
+        return code_prop->type;
+
+    return (length < 5) ? unknown_types[length] : MEP_BINARY;
+}
+//---------------------------------------------------------------------
+
+char viewResponse(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_PPTP_VIEW *view)
+{
+    uint8_t *decoded = NULL;
+
+    if (mep_frame == NULL || mep_frame_type > 1)
+    {
+        errno = EINVAL;
         return -1;
-    if (*offset >= p_size)
-        return 0;
-    if ((*offset)+size > p_size)
+    }
+
+    // The UoPTB frame is decoded in the same buffer.
+    if (mep_frame_type)
+    {
+        if ((decoded = AesysMepDecodeUPTBFrameInPlace(mep_frame,mep_frame_size)) == NULL)
+        {
+            errno = ENOEXEC;
+            return -1;
+        }
+
+        view->dlen    = ((tAESYS_MEP_UPTB_FRAME *) decoded)->pptp.dlen;
+        view->tran    = ((tAESYS_MEP_UPTB_FRAME *) decoded)->pptp.tran;
+        view->cmd     = ((tAESYS_MEP_UPTB_FRAME *) decoded)->pptp.cmd;
+        view->payload = &((tAESYS_MEP_UPTB_FRAME *) decoded)->pptp.payload;
+    }
+    else if (!AesysMepViewPPTPFrame(mep_frame,mep_frame_size,view))
+    {
+        errno = ENOEXEC;
         return -1;
+    }
 
-    GETVAL16(cmd->code,payload,*offset);
-    GETVAL32(cmd->offset,payload,*offset);
-    GETVAL16(cmd->length,payload,*offset);
-    cmd->data = NULL;
+#ifdef AESYS_MEP_GZIP
+    // The gzip responses can't be read in place, see AesysMepInflateResponseTo.
+    if (view->cmd == MEP_DAT_GZ)
+    {
+        errno = ENOTSUP;
+        return -1;
+    }
+#endif
 
-    // Validate data length
-    if (cmd->length)
+    if (view->cmd != MEP_DAT)
     {
-        if ((*offset)+cmd->length <= p_size)
-            cmd->data = &payload[*offset];
-        else
-            return -1;
+        errno = EPERM;
+        return -1;
+    }
 
-        *offset += cmd->length;
+    if (view->dlen == 0 || view->payload[0] != 0)
+    {
+        errno = ENOEXEC;
+        return -1;
     }
 
     return 1;
 }
 //---------------------------------------------------------------------
 
-char AesysMepReadNextGetCMD(uint8_t *payload, uint16_t p_size, uint16_t *offset, tAESYS_MEP_GET_CMD *cmd)
+char decodeGroup(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, const tAESYS_MEP_GROUP *group, void *info, uint16_t info_size)
 {
-    uint16_t size = sizeof(tAESYS_MEP_GET_CMD);
+    char ret;
+    uint8_t i, *field;
+    uint16_t offset = 1, next = 0, f, first = 1;
+    tAESYS_MEP_DAT_CMD dat;
+    tAESYS_MEP_PPTP_VIEW view;
+    tAESYS_MEP_GROUP_HEAD *head = (tAESYS_MEP_GROUP_HEAD *) info;
 
-    if (payload == NULL || offset == NULL || cmd == NULL || p_size < size)
+    if (info == NULL)
+    {
+        errno = EINVAL;
         return -1;
-    if (*offset >= p_size)
-        return 0;
-    if ((*offset)+size > p_size)
+    }
+
+    if (viewResponse(mep_frame,mep_frame_size,mep_frame_type,&view) == -1)
         return -1;
 
-    GETVAL16(cmd->code,payload,*offset);
-    GETVAL32(cmd->offset,payload,*offset);
+    memset(info,0,info_size);
+    head->tran = view.tran;
+
+    while ((ret = AesysMepReadNextDatCMD(view.payload,view.dlen,&offset,&dat)) == 1)
+    {
+        // The codes are expected in the same order of the request, so the
+        // search starts after the last code found.
+        for (i = 0, f = next; i < group->count && group->fields[f].code != dat.code; i++)
+             f = (f + 1 < group->count) ? f + 1 : 0;
+
+        if (i == group->count)
+        {
+            // The first code must be the sentinel or a code of the group.
+            if (first && dat.code != group->code)
+            {
+                errno = EBADMSG;
+                return -1;
+            }
+
+            first = 0;
+            continue;
+        }
+
+        first = 0;
+        next  = (f + 1 < group->count) ? f + 1 : 0;
+
+        if (dat.flags != 0 || (group->fields[f].size && dat.length != group->fields[f].size))
+            continue;
+
+        i     = 0;
+        field = (uint8_t *) info + group->fields[f].offset;
+
+        switch (group->fields[f].store)
+        {
+            case K_FIELD_U8:
+                 *field = dat.data[0];
+                 break;
+            case K_FIELD_U16:
+                 GETVAL16(*(uint16_t *) field,dat.data,i);
+                 break;
+            case K_FIELD_U32:
+                 GETVAL32(*(uint32_t *) field,dat.data,i);
+                 break;
+            case K_FIELD_I8_WIDE:
+                 *(int16_t *) field = (int8_t) dat.data[0];
+                 break;
+            case K_FIELD_U8_WIDE:
+                 *(int16_t *) field = dat.data[0];
+                 break;
+            default:
+                 ((tAESYS_MEP_STRING_VIEW *) field)->data   = (const char *) dat.data;
+                 ((tAESYS_MEP_STRING_VIEW *) field)->length = dat.length;
+                 break;
+        }
+
+        head->valid |= 1 << f;
+    }
+
+    if (ret == -1)
+    {
+        errno = ENOEXEC;
+        return -1;
+    }
 
     return 1;
 }
 //---------------------------------------------------------------------
 
-char AesysMepReadNextDatCMD(uint8_t *payload, uint16_t p_size, uint16_t *offset, tAESYS_MEP_DAT_CMD *cmd)
+char indexValue(const tAESYS_MEP_RESPONSE_INDEX *index, uint16_t code, uint8_t type1, uint8_t type2, uint16_t length, const uint8_t **data, uint16_t *size)
 {
-    uint16_t size = sizeof(tAESYS_MEP_DAT_CMD)-sizeof(uint8_t *);
+    const tAESYS_MEP_INDEX_ENTRY *entry = AesysMepFindIndexEntry(index,code);
 
-    if (payload == NULL || offset == NULL || cmd == NULL || p_size < size)
-        return -1;
-    if (*offset >= p_size)
+    // Not in the response, not supported by device or with error flag.
+    if (entry == NULL || entry->flag != 0)
         return 0;
-    if ((*offset)+size > p_size)
-        return -1;
-
-    GETVAL16(cmd->code,payload,*offset);
-    GETVAL32(cmd->offset,payload,*offset);
-    cmd->flags = payload[(*offset)++];
-    GETVAL16(cmd->length,payload,*offset);
-    cmd->data  = NULL;
 
-    // Validate data length
-    if (cmd->length)
-    {
-        if ((*offset)+cmd->length <= p_size)
-            cmd->data = &payload[*offset];
-        else
-            return -1;
+    // length 0 accepts any size.
+    if ((entry->type != type1 && entry->type != type2) || (length && entry->length != length))
+        return -1;
 
-        *offset += cmd->length;
-    }
+    *data = &index->payload[entry->offset];
+    if (size != NULL)
+        *size = entry->length;
 
     return 1;
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_RESPONSE * AesysMepParseResponse(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type)
+tAESYS_MEP_RESPONSE * parseResponse(const tAESYS_MEP_PPTP_VIEW *pptp, uint8_t arena)
 {
     char ret;
-    uint16_t offset = 1;
+    uint16_t offset = 1, nodes = 0;
     tAESYS_MEP_DAT_CMD dat;
-    tAESYS_MEP_PPTP_FRAME *pptp        = NULL;
+    uint8_t *payload = NULL, *values = NULL;
     tAESYS_MEP_RESPONSE *response      = NULL;
+    tAESYS_MEP_RESPONSE_DATA *node     = NULL;
     tAESYS_MEP_RESPONSE_DATA **current = NULL;
-    uint8_t *payload = NULL, *vframe   = NULL;
-    uint8_t unknown_types[] = {MEP_VOID,MEP_UINT8,MEP_UINT16,MEP_BINARY,MEP_UINT32};
+#ifdef AESYS_MEP_GZIP
+    tAESYS_MEP_PPTP_VIEW plain;
+    uint8_t inflated[K_MEP_MAX_DATA_SIZE];
+#endif
 
     #define RESPONSE_ERROR(e)           \
     {                                   \
-        free(vframe);                   \
         AesysMepFreeResponse(response); \
         errno = e;                      \
         return NULL;                    \
     }                                   \
 
-    if (mep_frame == NULL || mep_frame_type > 1)
-        RESPONSE_ERROR(EINVAL);
-
-    if (mep_frame_type)
-    {
-        if ((vframe = AesysMepDecodeUPTBFrame(mep_frame,mep_frame_size)) == NULL)
-            RESPONSE_ERROR(ENOEXEC);
-
-        tAESYS_MEP_UPTB_FRAME *uptb = (tAESYS_MEP_UPTB_FRAME *) vframe;
-        pptp = &uptb->pptp;
-    }
-    else
+#ifdef AESYS_MEP_GZIP
+    // The gzip responses are parsed from the inflated payload.
+    if (pptp->cmd == MEP_DAT_GZ)
     {
-        if ((vframe = AesysMepCncopyPPTPFrame(mep_frame,mep_frame_size)) == NULL)
+        plain = *pptp;
+        if (inflatePayload(&plain,inflated,sizeof(inflated)) != 1)
             RESPONSE_ERROR(ENOEXEC);
 
-        pptp = (tAESYS_MEP_PPTP_FRAME *) vframe;
+        pptp = &plain;
     }
+#endif
 
     if (pptp->cmd != MEP_DAT)
         RESPONSE_ERROR(EPERM);
 
-    payload = &pptp->payload;
-    if (payload[0] != 0)
+    payload = pptp->payload;
+    if (pptp->dlen == 0 || payload[0] != 0)
         RESPONSE_ERROR(ENOEXEC);
 
-    response = (tAESYS_MEP_RESPONSE *) calloc(1,sizeof (tAESYS_MEP_RESPONSE));
-    if (response == NULL)
-        RESPONSE_ERROR(ENOMEM);
+    // The arena have the response, the nodes and the values over 8 bytes. Every
+    // DAT command uses at least 9 bytes of payload so the payload size limits both.
+    if (arena)
+    {
+        nodes    = (pptp->dlen-1) / 9;
+        response = (tAESYS_MEP_RESPONSE *) malloc(sizeof (tAESYS_MEP_RESPONSE) +
+                                                  nodes * sizeof (tAESYS_MEP_RESPONSE_DATA) + pptp->dlen);
+        if (response == NULL)
+            RESPONSE_ERROR(ENOMEM);
+
+        memset(response,0,sizeof (tAESYS_MEP_RESPONSE));
+        response->arena = 1;
+        node   = (tAESYS_MEP_RESPONSE_DATA *) &response[1];
+        values = (uint8_t *) &node[nodes];
+    }
+    else
+    {
+        response = (tAESYS_MEP_RESPONSE *) calloc(1,sizeof (tAESYS_MEP_RESPONSE));
+        if (response == NULL)
+            RESPONSE_ERROR(ENOMEM);
+    }
 
     current = &response->data;
     response->tran = pptp->tran;
@@ -692,7 +1324,11 @@ tAESYS_MEP_RESPONSE * AesysMepParseResponse(uint8_t *mep_frame, uint16_t mep_fra
         if (dat.flags == 1) // Code not supported by device discard code response.
             continue;
 
-        *current = (tAESYS_MEP_RESPONSE_DATA *) calloc(1,sizeof (tAESYS_MEP_RESPONSE_DATA));
+        if (arena)
+            memset(*current = node++,0,sizeof (tAESYS_MEP_RESPONSE_DATA));
+        else
+            *current = (tAESYS_MEP_RESPONSE_DATA *) calloc(1,sizeof (tAESYS_MEP_RESPONSE_DATA));
+
         if (*current == NULL)
             RESPONSE_ERROR(ENOMEM);
 
@@ -702,15 +1338,22 @@ tAESYS_MEP_RESPONSE * AesysMepParseResponse(uint8_t *mep_frame, uint16_t mep_fra
 
         if (dat.length)
         {
-            const tAESYS_MEP_CODE_PROPERTIES *code_prop = AesysMepGetCodeProperties(dat.code);
-
-            if (code_prop != NULL)    (*current)->type = code_prop->type;
-            else if (dat.length < 5)  (*current)->type = unknown_types[dat.length];
-            else                      (*current)->type = MEP_BINARY;
-
-            (*current)->resp_data = calloc(1,(*current)->size);
-            if ((*current)->resp_data == NULL)
-                RESPONSE_ERROR(ENOMEM);
+            (*current)->type = responseType(dat.code,dat.length);
+
+            // The small values are saved inside the node.
+            if (dat.length <= sizeof ((*current)->value))
+                (*current)->resp_data = (*current)->value;
+            else if (arena)
+            {
+                (*current)->resp_data = values;
+                values += dat.length;
+            }
+            else
+            {
+                (*current)->resp_data = malloc(dat.length);
+                if ((*current)->resp_data == NULL)
+                    RESPONSE_ERROR(ENOMEM);
+            }
 
             memcpy((*current)->resp_data,dat.data,dat.length);
         }
@@ -721,561 +1364,2869 @@ tAESYS_MEP_RESPONSE * AesysMepParseResponse(uint8_t *mep_frame, uint16_t mep_fra
     if (ret < 0)
         RESPONSE_ERROR(EILSEQ);
 
-    free(vframe);
-
     return response;
 }
 //---------------------------------------------------------------------
 
-char AesysMepReadNextVisExtData(uint8_t *payload, uint16_t p_size, uint16_t *offset, uint16_t *elements, tAESYS_MEP_VIS_EXT_DATA *p_data)
+tAESYS_MEP_RESPONSE * parseMEPFrame(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, uint8_t arena)
 {
-    uint8_t noe, nop;
-    uint16_t size = sizeof (tAESYS_MEP_VIS_EXT_DATA) + 1;
+    uint8_t *vframe = NULL, decoded[K_MEP_MAX_DATA_SIZE+11];
+    tAESYS_MEP_PPTP_VIEW view;
 
-    if (payload  == NULL || offset == NULL || elements == NULL || p_data  == NULL)
-        return -1;
+    if (mep_frame == NULL || mep_frame_type > 1)
+    {
+        errno = EINVAL;
+        return NULL;
+    }
 
-    if (payload[0] == 0)
+    // The PPTP frame is parsed from the received buffer without copy it. The
+    // UoPTB frame is decoded in the stack with the same layout of the deframer.
+    if (mep_frame_type)
     {
-        if (p_size > 1)
-            return -1;
+        if ((vframe = decodeUPTBFrame(mep_frame,mep_frame_size,decoded)) == NULL)
+        {
+            errno = ENOEXEC;
+            return NULL;
+        }
 
-        return 0;
+        view.dlen    = ((tAESYS_MEP_UPTB_FRAME *) vframe)->pptp.dlen;
+        view.tran    = ((tAESYS_MEP_UPTB_FRAME *) vframe)->pptp.tran;
+        view.cmd     = ((tAESYS_MEP_UPTB_FRAME *) vframe)->pptp.cmd;
+        view.payload = &((tAESYS_MEP_UPTB_FRAME *) vframe)->pptp.payload;
+    }
+    else if (!AesysMepViewPPTPFrame(mep_frame,mep_frame_size,&view))
+    {
+        errno = ENOEXEC;
+        return NULL;
     }
 
-    p_data->page = NULL;
-    noe = *elements >> 8;
-    nop = *elements & 0xFF;
+    return parseResponse(&view,arena);
+}
+//---------------------------------------------------------------------
 
-    if (*offset >= p_size)
+tAESYS_MEP_BUFFER * createSendMEPFrame(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t addrs, uint16_t dlen, uint16_t trans, uint8_t cmd, uint8_t *data)
+{
+    tAESYS_MEP_UPTB_FRAME uptbFrame = { .crc = 0, .addr = htons(addrs), .pptp.dlen = htons(dlen), .pptp.tran = htons(trans), .pptp.cmd = cmd, };
+    uint16_t offset  = 0, headSize  = 5   , crc = 0xFFFF, frameSize = headSize + dlen, limit;
+    uint8_t  txBytes = 0, fits = 0, *dst = NULL, *ptrFrame = (uint8_t *) &uptbFrame.pptp;
+    tAESYS_MEP_BUFFER *frame  = NULL;
+
+    if (type)
     {
-        if (noe != payload[0])
-            return -1;
+        frameSize += 4;
+        headSize  += 2;
+        ptrFrame   = (uint8_t *) &uptbFrame;
+        ptrFrame  += 2;
+        txBytes    = (type == MEP_UPTBNTX) ? 0 : 2;
+    }
 
-        return 0;
+    if (frameSize > K_MEP_MAX_FRAME_SIZE || dlen > K_MEP_MAX_DATA_SIZE || type > 2)
+        goto CSFRAME_ERROR;
+
+    // Without output the frame is allocated for the worst case where every byte is
+    // escaped. Otherwise is written in the developer buffer.
+    if (output == NULL)
+    {
+        frame = (tAESYS_MEP_BUFFER *) calloc(1,sizeof(tAESYS_MEP_BUFFER));
+        if (frame == NULL)
+            goto CSFRAME_ERROR;
+
+        limit       = AesysMepGetMaxFrameSize(type,dlen);
+        frame->data = (uint8_t *) malloc(limit);
+        if (frame->data == NULL)
+            goto CSFRAME_ERROR;
+
+        dst = frame->data;
+    }
+    else
+    {
+        dst   = output->data;
+        limit = output->size;
     }
 
-    if (nop == 0)
+    switch (type)
     {
-        if ((*offset)+2 > p_size)
-            return -1;
+        case  MEP_PPTP:
+            offset = frameSize;
+            fits   = (frameSize <= limit);
+            if (fits)
+            {
+                memcpy(dst,ptrFrame,headSize);
+                memcpy(&dst[headSize],data,dlen);
+            }
+        break;
+        case MEP_UPTB:
+        case MEP_UPTBNTX:
+            // Reserve the ETX byte.
+            offset = ((txBytes) ? 1 : 0);
+            limit  = (limit > offset) ? limit-offset : 0;
 
-        p_data->id = payload[(*offset)++];
-        nop        = payload[(*offset)++];
+            encodeToUPTBFrame(ptrFrame,headSize,dst,limit,&offset,&crc);
+            encodeToUPTBFrame(data,dlen,dst,limit,&offset,&crc);
 
-        noe++;
-        *elements = ((*elements)&0x00FF) | (noe<<8);
+            crc  = htons(crc);
+            fits = encodeToUPTBFrame((uint8_t *) &crc,2,dst,limit,&offset,NULL);
 
-        if (nop == 0)
-            return 1;
-    }
+            if (offset - ((txBytes) ? 1 : 0) > K_MEP_MAX_FRAME_SIZE)
+                goto CSFRAME_ERROR;
 
-    if ((*offset)+size > p_size)
-        return -1;
+            // Check if add the TX bytes: STX and ETX
+            if (txBytes)
+            {
+                if (fits)
+                {
+                    dst[0]      = K_MEP_STX;
+                    dst[offset] = K_MEP_ETX;
+                }
+                offset++;
+            }
+        break;
+    }
 
-    p_data->page = (tAESYS_MEP_VIS_EXT_PAGE *) &payload[*offset];
+    if (output != NULL)
+    {
+        output->size   = offset;
+        output->result = fits;
+        return NULL;
+    }
 
-    // Validate the pageDef size according to property size
-    size = ntohs(p_data->page->size);
-    *offset += size+5;
+    frame->size = offset;
 
-    if (*offset > p_size)
-        return -1;
+    return frame;
 
-    nop--;
-    *elements = ((*elements)&0xFF00) | nop;
+    CSFRAME_ERROR:
 
-    return 1;
+    if (frame != NULL) {
+        if (frame->data != NULL)
+            free(frame->data);
+        free(frame);
+    }
+
+    return NULL;
+}
+//---------------------------------------------------------------------
+
+int addTextProperties(uint8_t *buffer, uint16_t *offset, const tAESYS_MEP_MSG_DATA *msg, const tAESYS_MEP_PANEL_DATA *panel, tAESYS_MEP_TEXT_SPAN *spans)
+{
+    uint8_t  cmds[K_TXT_ROW_MAX];
+    uint16_t lpdh, lpdv;
+    uint16_t rows, cols;
+    uint16_t vAlign, hAlign;
+    uint16_t j = *offset, n;
+    uint8_t  rowSpacing, colSpacing;
+    const tAESYS_MEP_MSG_ROW *row;
+
+    // ### CONSTRUCT THE DRAWING COMMANDS ###
+    // The commands are written straight to the buffer. The buffer have the
+    // max data size, so the size is checked before write each block.
+    n = ((msg->blinking_text == 1) ? 2 : 0) + ((msg->antialiasing > 0 && msg->antialiasing <= 9) ? 3 : 0);
+    if (j + n > K_MEP_MAX_DATA_SIZE)
+        return -1;
+
+    // Blinking text
+    if (msg->blinking_text == 1)
+    {
+        buffer[j++] = K_TXT_CMD;
+        buffer[j++] = 0x41;
+    }
+
+    // Antialiasing
+    if (msg->antialiasing > 0 && msg->antialiasing <= 9)
+    {
+        buffer[j++] = K_TXT_CMD;
+        buffer[j++] = 0x42;
+        buffer[j++] = msg->antialiasing + '0';
+    }
+
+    // Get the vertical leds used by each letter
+    // and calculate the max number of rows supported by the device.
+    rowSpacing = (msg->row_spacing > 9 || msg->total_rows == 1) ? 0 : msg->row_spacing;
+    lpdv = panel->font_size[1]+rowSpacing;
+
+    if (msg->truncate)
+    {
+        rows = (panel->panel_size[1]+rowSpacing)/lpdv;
+        if (rows == 0 || msg->total_rows < rows)
+            rows = msg->total_rows;
+    }
+    else
+        rows = msg->total_rows;
+
+    // Calculate the vertical alignment for the first element.
+    vAlign = panel->panel_size[1] - ((lpdv * rows) - rowSpacing);        // Bottom.
+
+    if (vAlign > panel->panel_size[1] || !msg->v_alignment) vAlign  = 0;  // Top or invalid value.
+    else if (msg->v_alignment == 1)                         vAlign /= 2;  // Center.
+
+    for (uint16_t r = 0; r < rows; r++)
+    {
+         row = &msg->rows[r];
+
+         // Get the horizontal leds used by each letter
+         // and calculate the aprox max number of cols supported by the device.
+         colSpacing = (row->col_spacing > 9 ) ? 0 : row->col_spacing;
+         lpdh = panel->font_size[0]+colSpacing;
+         if (msg->truncate && !row->compact_font)
+         {
+             cols = (panel->panel_size[0]+colSpacing)/lpdh;
+             if (cols == 0 || row->msg_size < cols)
+                 cols = row->msg_size;
+         }
+         else
+             cols = row->msg_size;
+
+         // Calculate the horizontal alignment. If compactfont is true,
+         // then disable horizontal aligment because the size of each letter is variable.
+         hAlign = panel->panel_size[0] - ((lpdh * cols) - colSpacing);               // Right.
+
+         if (hAlign > panel->panel_size[0] || !row->h_alignment || row->compact_font)  // Left, invalid value or compactFont is set.
+             hAlign  = 0;
+         else if (row->h_alignment == 1)                                               // Center.
+             hAlign /= 2;
+
+         // The row commands are composed on the stack and copied with the text.
+         n = 0;
+
+         // Basic color or RGBY color. The RGBY color is exactly 4 hex chars.
+         if (row->custom_colors[0] && row->custom_colors[0] <= 5)
+         {
+             cmds[n++] = K_TXT_CMD;
+             cmds[n++] = 0x43;
+             cmds[n++] = row->custom_colors[0] - 1 + '0';
+         }
+         else if (row->custom_colors[0] == 6 && isxdigit(row->custom_colors[1]) &&
+                  isxdigit(row->custom_colors[2]) && isxdigit(row->custom_colors[3]) &&
+                  isxdigit(row->custom_colors[4]))
+         {
+             cmds[n++] = K_TXT_CMD;
+             cmds[n++] = 0x44;
+             memcpy(&cmds[n],&row->custom_colors[1],4);
+             n += 4;
+         }
+
+         // Scrolling
+         if (row->scrolling_speed >= 1 && row->scrolling_speed <= 9)
+         {
+             cmds[n++] = K_TXT_CMD;
+             cmds[n++] = 0x53;
+             cmds[n++] = 0x48;
+             cmds[n++] = row->scrolling_speed + '0';
+         }
+
+         // Set Position (vertical and horizontal alignment as hex value), font, col & row Spacing
+         cmds[n++] = K_TXT_CMD;
+         cmds[n++] = 0x51;
+         n += writeHexPosition(&cmds[n],vAlign);
+         n += writeHexPosition(&cmds[n],hAlign);
+         cmds[n++] = K_TXT_CMD;
+         cmds[n++] = 0x46;
+         cmds[n++] = 0x31;
+         cmds[n++] = colSpacing + '0';
+         cmds[n++] = rowSpacing + '0';
+
+         if (row->compact_font)
+         {
+             cmds[n++] = K_TXT_CMD;
+             cmds[n++] = 0x4F;
+         }
+
+         if (j + n + cols > K_MEP_MAX_DATA_SIZE)
+             return -1;
+
+         if (spans != NULL)
+         {
+             spans[r].offset = j + n;
+             spans[r].size   = cols;
+         }
+
+         memcpy(&buffer[j],cmds,n);
+         memcpy(&buffer[j+n],row->msg,cols);
+         j      += n + cols;
+         vAlign += lpdv;
+    }
+
+    n = j - *offset;
+    *offset = j;
+
+    return n;
+}
+//---------------------------------------------------------------------
+
+uint8_t writeHexPosition(uint8_t *dst, uint16_t value)
+{
+    // Same as "%.3X": at least 3 upper case digits.
+    uint8_t size = (value > 0x0FFF) ? 4 : 3;
+
+    for (uint8_t i = size; i > 0; i--, value >>= 4)
+         dst[i-1] = hex_digits[value & 0x0F];
+
+    return size;
+}
+
+//---------------------------------------------------------------------
+/**********************************************************************
+*****                       PUBLIC FUNCTIONS                      *****
+*****                        Decode section                       *****
+**********************************************************************/
+
+const tAESYS_MEP_CODE_PROPERTIES * AesysMepGetCodeProperties(uint16_t code)
+{
+    uint8_t i = records_hash[CODE_HASH(code)];
+
+    // Duplicated case values don't compile, so the hash have not collisions.
+    #define HASH_CASE(name,code,nbne,iops,type) case CODE_HASH(code):
+    switch (0) { AESYS_MEP_CODES_LIST(HASH_CASE) default: break; }
+    #undef HASH_CASE
+
+    if (i != 0 && records[i-1].code == code)
+        return &records[i-1];
+
+    return NULL;
+}
+//---------------------------------------------------------------------
+
+const char * AesysMepGetCodeName(uint16_t code)
+{
+    const tAESYS_MEP_CODE_PROPERTIES *code_prop = AesysMepGetCodeProperties(code);
+
+    if (code_prop != NULL)
+        return records_names[code_prop - records];
+
+    if (code >= MEP_CUSTOM_SET_TEXT && code < MEP_CUSTOM_SET_TEXT + K_CUSTOMS_COUNT)
+        return custom_names[code - MEP_CUSTOM_SET_TEXT];
+
+    return NULL;
+}
+//---------------------------------------------------------------------
+
+uint8_t * AesysMepDecodeUPTBFrame(const uint8_t *frame, uint16_t frame_size)
+{
+    return decodeUPTBFrame(frame,frame_size,NULL);
+}
+//---------------------------------------------------------------------
+
+uint8_t * AesysMepDecodeUPTBFrameInPlace(uint8_t *frame, uint16_t frame_size)
+{
+    if (frame == NULL)
+        return NULL;
+
+    return decodeUPTBFrame(frame,frame_size,frame);
+}
+//---------------------------------------------------------------------
+
+uint8_t * AesysMepCncopyPPTPFrame(const uint8_t *frame, uint16_t frame_size)
+{
+    uint16_t size, offset = 0;
+    uint8_t *duplicate = NULL;
+
+    if (frame != NULL && frame_size >= K_MEP_MIN_SIZE_PPTB)
+    {
+        // Check if have a valid command
+        if (!isValidCommand(frame[4]))
+            return NULL;
+
+        // Check the data size is valid.
+        GETVAL16(size,frame,offset);
+        if (size > K_MEP_MAX_DATA_SIZE || size != frame_size-5)
+            return NULL;
+
+        // Alloc memory for the new frame, copy and transform the header.
+        duplicate = (uint8_t *) calloc(frame_size,sizeof(uint8_t));
+
+        if (duplicate != NULL)
+        {
+            memcpy(duplicate,frame,frame_size);
+            swapStrBytes(duplicate,frame_size,2,2);
+        }
+    }
+
+    return duplicate;
+}
+//---------------------------------------------------------------------
+
+uint8_t AesysMepViewPPTPFrame(uint8_t *frame, uint16_t frame_size, tAESYS_MEP_PPTP_VIEW *view)
+{
+    uint16_t offset = 0;
+
+    // The frame must have only one PPTP frame.
+    if (frame == NULL || frame_size < K_MEP_MIN_SIZE_PPTB)
+        return 0;
+
+    return (AesysMepReadNextPPTPFrame(frame,frame_size,&offset,view) == 1 && offset == frame_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepReadNextPPTPFrame(uint8_t *data, uint16_t d_size, uint16_t *offset, tAESYS_MEP_PPTP_VIEW *view)
+{
+    uint16_t i;
+
+    if (data == NULL || offset == NULL || view == NULL || *offset > d_size)
+        return -1;
+
+    // Wait until the header is complete.
+    i = *offset;
+    if (d_size-i < 5)
+        return 0;
+
+    GETVAL16(view->dlen,data,i);
+    GETVAL16(view->tran,data,i);
+    view->cmd     = data[i++];
+    view->payload = &data[i];
+
+    if (view->dlen > K_MEP_MAX_DATA_SIZE || !isValidCommand(view->cmd))
+        return -1;
+
+    if (d_size-i < view->dlen)
+        return 0;
+
+    *offset = i + view->dlen;
+
+    return 1;
+}
+//---------------------------------------------------------------------
+
+void AesysMepInitUPTBDeframer(tAESYS_MEP_UPTB_DEFRAMER *deframer)
+{
+    if (deframer != NULL)
+    {
+        deframer->state  = K_DEFRAMER_SYNC;
+        deframer->escape = 0;
+        deframer->errors = 0;
+    }
+}
+//---------------------------------------------------------------------
+
+char AesysMepReadNextUPTBFrame(tAESYS_MEP_UPTB_DEFRAMER *deframer, const uint8_t *data, uint16_t d_size, uint16_t *offset)
+{
+    uint8_t byte;
+    uint16_t i, run, crc;
+    const uint8_t *stx = NULL;
+    const uint8_t stops[3] = {K_MEP_STX,K_MEP_ETX,K_MEP_DLE};
+
+    #define DEFRAMER_DISCARD()                  \
+    {                                           \
+        deframer->state = K_DEFRAMER_SYNC;      \
+        deframer->errors++;                     \
+        continue;                               \
+    }                                           \
+
+    if (deframer == NULL || data == NULL || offset == NULL || *offset > d_size)
+        return -1;
+
+    for (i = *offset; i < d_size; )
+    {
+         // Discard all bytes until the STX.
+         if (deframer->state == K_DEFRAMER_SYNC)
+         {
+             if ((stx = memchr(&data[i],K_MEP_STX,d_size-i)) == NULL)
+                 break;
+
+             i = (stx-data) + 1;
+             deframer->state  = K_DEFRAMER_DATA;
+             deframer->escape = 0;
+             deframer->size   = 0;
+             deframer->crc    = 0xFFFF;
+             continue;
+         }
+
+         // The DLE was the last byte of the previous chunk.
+         if (deframer->escape)
+         {
+             deframer->escape = 0;
+             if (data[i] != K_DSTX && data[i] != K_DETX && data[i] != K_DDLE)
+                 DEFRAMER_DISCARD();
+
+             byte = data[i++] - K_DINC;
+             if (!appendToDeframer(deframer,&byte,1))
+                 DEFRAMER_DISCARD();
+
+             continue;
+         }
+
+         run = findEscapeByte(&data[i],d_size-i,stops);
+         if (!appendToDeframer(deframer,&data[i],run))
+             DEFRAMER_DISCARD();
+
+         i += run;
+         if (i == d_size)
+             break;
+
+         // A STX inside the frame starts a new frame.
+         if (data[i] == K_MEP_STX)
+             DEFRAMER_DISCARD();
+
+         i++;
+         if (data[i-1] == K_MEP_DLE)
+         {
+             deframer->escape = 1;
+             continue;
+         }
+
+         // ETX. Check the length and the CRC.
+         deframer->state = K_DEFRAMER_SYNC;
+         if (deframer->size < K_UPTB_HEAD_SIZE || deframer->size != K_UPTB_HEAD_SIZE + deframer->dlen + 2)
+         {
+             deframer->errors++;
+             continue;
+         }
+
+         run = deframer->size;
+         crc = (deframer->frame[run] << 8) | deframer->frame[run+1];
+         if (crc != deframer->crc)
+         {
+             deframer->errors++;
+             continue;
+         }
+
+         // Same format of AesysMepDecodeUPTBFrame.
+         swapStrBytes(&deframer->frame[2],6,2,3);
+         memcpy(&deframer->frame[0],&crc,2);
+
+         *offset = i;
+         return 1;
+    }
+
+    *offset = d_size;
+
+    return 0;
+}
+//---------------------------------------------------------------------
+
+char AesysMepReadNextDelCMD(uint8_t *payload, uint16_t p_size, uint16_t *offset, uint16_t *code)
+{
+    uint16_t size = sizeof(uint16_t);
+
+    if (payload == NULL || offset == NULL || code == NULL || p_size < size)
+        return -1;
+    if (*offset >= p_size)
+        return 0;
+    if ((*offset)+size > p_size)
+        return -1;
+
+    GETVAL16(*code,payload,*offset);
+
+    return 1;
+}
+//---------------------------------------------------------------------
+
+char AesysMepReadNextSetCMD(uint8_t *payload, uint16_t p_size, uint16_t *offset, tAESYS_MEP_SET_CMD *cmd)
+{
+    uint16_t size = sizeof(tAESYS_MEP_SET_CMD)-sizeof(uint8_t *);
+
+    if (payload == NULL || offset == NULL || cmd == NULL || p_size < size)
+        return -1;
+    if (*offset >= p_size)
+        return 0;
+    if ((*offset)+size > p_size)
+        return -1;
+
+    GETVAL16(cmd->code,payload,*offset);
+    GETVAL32(cmd->offset,payload,*offset);
+    GETVAL16(cmd->length,payload,*offset);
+    cmd->data = NULL;
+
+    // Validate data length
+    if (cmd->length)
+    {
+        if ((*offset)+cmd->length <= p_size)
+            cmd->data = &payload[*offset];
+        else
+            return -1;
+
+        *offset += cmd->length;
+    }
+
+    return 1;
+}
+//---------------------------------------------------------------------
+
+char AesysMepReadNextGetCMD(uint8_t *payload, uint16_t p_size, uint16_t *offset, tAESYS_MEP_GET_CMD *cmd)
+{
+    uint16_t size = sizeof(tAESYS_MEP_GET_CMD);
+
+    if (payload == NULL || offset == NULL || cmd == NULL || p_size < size)
+        return -1;
+    if (*offset >= p_size)
+        return 0;
+    if ((*offset)+size > p_size)
+        return -1;
+
+    GETVAL16(cmd->code,payload,*offset);
+    GETVAL32(cmd->offset,payload,*offset);
+
+    return 1;
+}
+//---------------------------------------------------------------------
+
+char AesysMepReadNextDatCMD(uint8_t *payload, uint16_t p_size, uint16_t *offset, tAESYS_MEP_DAT_CMD *cmd)
+{
+    uint16_t size = sizeof(tAESYS_MEP_DAT_CMD)-sizeof(uint8_t *);
+
+    if (payload == NULL || offset == NULL || cmd == NULL || p_size < size)
+        return -1;
+    if (*offset >= p_size)
+        return 0;
+    if ((*offset)+size > p_size)
+        return -1;
+
+    GETVAL16(cmd->code,payload,*offset);
+    GETVAL32(cmd->offset,payload,*offset);
+    cmd->flags = payload[(*offset)++];
+    GETVAL16(cmd->length,payload,*offset);
+    cmd->data  = NULL;
+
+    // Validate data length
+    if (cmd->length)
+    {
+        if ((*offset)+cmd->length <= p_size)
+            cmd->data = &payload[*offset];
+        else
+            return -1;
+
+        *offset += cmd->length;
+    }
+
+    return 1;
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_RESPONSE * AesysMepParseResponse(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type)
+{
+    return parseMEPFrame(mep_frame,mep_frame_size,mep_frame_type,0);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_RESPONSE * AesysMepParseResponseArena(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type)
+{
+    return parseMEPFrame(mep_frame,mep_frame_size,mep_frame_type,1);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_RESPONSE * AesysMepParseDecodedUPTBFrame(uint8_t *decoded)
+{
+    tAESYS_MEP_PPTP_VIEW view;
+    tAESYS_MEP_UPTB_FRAME *uptb = (tAESYS_MEP_UPTB_FRAME *) decoded;
+
+    if (decoded == NULL)
+    {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    view.dlen    = uptb->pptp.dlen;
+    view.tran    = uptb->pptp.tran;
+    view.cmd     = uptb->pptp.cmd;
+    view.payload = &uptb->pptp.payload;
+
+    return parseResponse(&view,0);
+}
+//---------------------------------------------------------------------
+
+char AesysMepInitDatIterator(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_DAT_ITERATOR *iterator)
+{
+    tAESYS_MEP_PPTP_VIEW view;
+
+    if (iterator == NULL)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (viewResponse(mep_frame,mep_frame_size,mep_frame_type,&view) == -1)
+        return -1;
+
+    // Skip the status byte.
+    iterator->tran    = view.tran;
+    iterator->dlen    = view.dlen;
+    iterator->offset  = 1;
+    iterator->payload = view.payload;
+
+    return 1;
+}
+//---------------------------------------------------------------------
+
+char AesysMepReadNextDatIterator(tAESYS_MEP_DAT_ITERATOR *iterator, tAESYS_MEP_DAT_CMD *cmd, uint8_t *type)
+{
+    char ret;
+
+    if (iterator == NULL)
+        return -1;
+
+    ret = AesysMepReadNextDatCMD(iterator->payload,iterator->dlen,&iterator->offset,cmd);
+
+    // The type is only searched if requested.
+    if (ret == 1 && type != NULL)
+        *type = responseType(cmd->code,cmd->length);
+
+    return ret;
+}
+//---------------------------------------------------------------------
+
+char AesysMepIndexResponse(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_RESPONSE_INDEX *index)
+{
+    char ret;
+    uint16_t offset = 1, i;
+    tAESYS_MEP_DAT_CMD dat;
+    tAESYS_MEP_PPTP_VIEW view;
+    tAESYS_MEP_INDEX_ENTRY entry;
+
+    if (index == NULL)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (viewResponse(mep_frame,mep_frame_size,mep_frame_type,&view) == -1)
+        return -1;
+
+    index->tran    = view.tran;
+    index->type    = 0;
+    index->count   = 0;
+    index->payload = view.payload;
+
+    while ((ret = AesysMepReadNextDatCMD(view.payload,view.dlen,&offset,&dat)) == 1)
+    {
+        if (index->type == 0)
+            index->type = dat.code;
+
+        entry.code   = dat.code;
+        entry.flag   = dat.flags;
+        entry.type   = responseType(dat.code,dat.length);
+        entry.offset = offset - dat.length;
+        entry.length = dat.length;
+
+        // Insert sorted by code. The responses are usually sorted already.
+        for (i = index->count; i > 0 && index->entries[i-1].code > entry.code; i--)
+             index->entries[i] = index->entries[i-1];
+
+        index->entries[i] = entry;
+        index->count++;
+    }
+
+    if (ret < 0)
+    {
+        errno = EILSEQ;
+        return -1;
+    }
+
+    return 1;
+}
+//---------------------------------------------------------------------
+
+const tAESYS_MEP_INDEX_ENTRY * AesysMepFindIndexEntry(const tAESYS_MEP_RESPONSE_INDEX *index, uint16_t code)
+{
+    uint16_t low = 0, high, mid;
+
+    if (index == NULL)
+        return NULL;
+
+    // Binary search of the first entry with the code.
+    high = index->count;
+    while (low < high)
+    {
+        mid = (low + high) / 2;
+        if (index->entries[mid].code < code)
+            low  = mid + 1;
+        else
+            high = mid;
+    }
+
+    if (low < index->count && index->entries[low].code == code)
+        return &index->entries[low];
+
+    return NULL;
+}
+//---------------------------------------------------------------------
+
+char AesysMepGetU8(const tAESYS_MEP_RESPONSE_INDEX *index, uint16_t code, uint8_t *value)
+{
+    char ret;
+    const uint8_t *data = NULL;
+
+    if (value == NULL)
+        return -1;
+
+    if ((ret = indexValue(index,code,MEP_UINT8,MEP_BOOL,1,&data,NULL)) == 1)
+        *value = data[0];
+
+    return ret;
+}
+//---------------------------------------------------------------------
+
+char AesysMepGetI8(const tAESYS_MEP_RESPONSE_INDEX *index, uint16_t code, int8_t *value)
+{
+    char ret;
+    const uint8_t *data = NULL;
+
+    if (value == NULL)
+        return -1;
+
+    if ((ret = indexValue(index,code,MEP_INT8,MEP_INT8,1,&data,NULL)) == 1)
+        *value = (int8_t) data[0];
+
+    return ret;
+}
+//---------------------------------------------------------------------
+
+char AesysMepGetU16(const tAESYS_MEP_RESPONSE_INDEX *index, uint16_t code, uint16_t *value)
+{
+    char ret;
+    uint16_t offset = 0;
+    const uint8_t *data = NULL;
+
+    if (value == NULL)
+        return -1;
+
+    if ((ret = indexValue(index,code,MEP_UINT16,MEP_UINT16,2,&data,NULL)) == 1)
+        GETVAL16(*value,data,offset);
+
+    return ret;
+}
+//---------------------------------------------------------------------
+
+char AesysMepGetU32(const tAESYS_MEP_RESPONSE_INDEX *index, uint16_t code, uint32_t *value)
+{
+    char ret;
+    uint16_t offset = 0;
+    const uint8_t *data = NULL;
+
+    if (value == NULL)
+        return -1;
+
+    if ((ret = indexValue(index,code,MEP_UINT32,MEP_UINT32,4,&data,NULL)) == 1)
+        GETVAL32(*value,data,offset);
+
+    return ret;
+}
+//---------------------------------------------------------------------
+
+char AesysMepGetString(const tAESYS_MEP_RESPONSE_INDEX *index, uint16_t code, const char **value, uint16_t *length)
+{
+    char ret;
+    const uint8_t *data = NULL;
+
+    if (value == NULL || length == NULL)
+        return -1;
+
+    if ((ret = indexValue(index,code,MEP_STRING,MEP_USTRING,0,&data,length)) == 1)
+        *value = (const char *) data;
+
+    return ret;
+}
+//---------------------------------------------------------------------
+
+char AesysMepDecodeDiagnosticInfo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_DIAGNOSTIC_INFO *info)
+{
+    return decodeGroup(mep_frame,mep_frame_size,mep_frame_type,&diag_group,info,sizeof(tAESYS_MEP_DIAGNOSTIC_INFO));
+}
+//---------------------------------------------------------------------
+
+char AesysMepDecodeDeviceInfo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_DEVICE_INFO *info)
+{
+    return decodeGroup(mep_frame,mep_frame_size,mep_frame_type,&devinfo_group,info,sizeof(tAESYS_MEP_DEVICE_INFO));
+}
+//---------------------------------------------------------------------
+
+char AesysMepDecodeTempInfo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_SENSORS_INFO *info)
+{
+    return decodeGroup(mep_frame,mep_frame_size,mep_frame_type,&temp_group,info,sizeof(tAESYS_MEP_SENSORS_INFO));
+}
+//---------------------------------------------------------------------
+
+char AesysMepDecodeHumidityInfo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_SENSORS_INFO *info)
+{
+    return decodeGroup(mep_frame,mep_frame_size,mep_frame_type,&hum_group,info,sizeof(tAESYS_MEP_SENSORS_INFO));
+}
+//---------------------------------------------------------------------
+
+char AesysMepDecodeBrightnessInfo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_SENSORS_INFO *info)
+{
+    return decodeGroup(mep_frame,mep_frame_size,mep_frame_type,&bright_group,info,sizeof(tAESYS_MEP_SENSORS_INFO));
+}
+//---------------------------------------------------------------------
+
+char AesysMepDecodeEnvBrightnessInfo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_SENSORS_INFO *info)
+{
+    return decodeGroup(mep_frame,mep_frame_size,mep_frame_type,&ebright_group,info,sizeof(tAESYS_MEP_SENSORS_INFO));
+}
+//---------------------------------------------------------------------
+
+char AesysMepDecodeTrafficLightInfo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_SENSORS_INFO *info)
+{
+    return decodeGroup(mep_frame,mep_frame_size,mep_frame_type,&traffic_group,info,sizeof(tAESYS_MEP_SENSORS_INFO));
+}
+//---------------------------------------------------------------------
+
+char AesysMepReadNextVisExtData(uint8_t *payload, uint16_t p_size, uint16_t *offset, uint16_t *elements, tAESYS_MEP_VIS_EXT_DATA *p_data)
+{
+    uint8_t noe, nop;
+    uint16_t size = sizeof (tAESYS_MEP_VIS_EXT_DATA) + 1;
+
+    if (payload  == NULL || offset == NULL || elements == NULL || p_data  == NULL)
+        return -1;
+
+    if (payload[0] == 0)
+    {
+        if (p_size > 1)
+            return -1;
+
+        return 0;
+    }
+
+    p_data->page = NULL;
+    noe = *elements >> 8;
+    nop = *elements & 0xFF;
+
+    if (*offset >= p_size)
+    {
+        if (noe != payload[0])
+            return -1;
+
+        return 0;
+    }
+
+    if (nop == 0)
+    {
+        if ((*offset)+2 > p_size)
+            return -1;
+
+        p_data->id = payload[(*offset)++];
+        nop        = payload[(*offset)++];
+
+        noe++;
+        *elements = ((*elements)&0x00FF) | (noe<<8);
+
+        if (nop == 0)
+            return 1;
+    }
+
+    if ((*offset)+size > p_size)
+        return -1;
+
+    p_data->page = (tAESYS_MEP_VIS_EXT_PAGE *) &payload[*offset];
+
+    // Validate the pageDef size according to property size
+    size = ntohs(p_data->page->size);
+    *offset += size+5;
+
+    if (*offset > p_size)
+        return -1;
+
+    nop--;
+    *elements = ((*elements)&0xFF00) | nop;
+
+    return 1;
+}
+//---------------------------------------------------------------------
+/**********************************************************************
+*****                     Device Info section                     *****
+**********************************************************************/
+
+tAESYS_MEP_BUFFER * buildClockInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id)
+{
+    tAESYS_MEP_GET_CMD clock_info = { .code = htons(MEP_CLOCK), .offset = 0, };
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof (clock_info),trans_id,MEP_GET,(uint8_t *) &clock_info);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildDeviceInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id)
+{
+    tAESYS_MEP_GET_CMD hw_info[] = {
+                                      { .code = htons(MEP_CUSTOM_DEVICE_INFO_DATA), .offset = 0, },
+                                      { .code = htons(MEP_HARDWARE_MODEL)         , .offset = 0, },
+                                      { .code = htons(MEP_FIRMWARE_MODEL)         , .offset = 0, },
+                                      { .code = htons(MEP_FIRMWARE_VERSION)       , .offset = 0, },
+                                      { .code = htons(MEP_FIRMWARE_RELEASE)       , .offset = 0, },
+                                      { .code = htons(MEP_FIRMWARE_DEVICE_TYPE)   , .offset = 0, },
+                                      { .code = htons(MEP_DEVICE_ID)              , .offset = 0, },
+                                      { .code = htons(MEP_DEVICE_DESCRIPTION)     , .offset = 0, },
+                                  };
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof (hw_info),trans_id,MEP_GET,(uint8_t *) hw_info);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildDevStatusInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id)
+{
+    tAESYS_MEP_GET_CMD dev_status [] = {
+                                         { .code = htons(MEP_CUSTOM_STATUS_INFO_DATA), .offset = 0, },
+                                         { .code = htons(MEP_STATUS)                 , .offset = 0, },
+                                       };
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof (dev_status),trans_id,MEP_GET,(uint8_t *) dev_status);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildDiagnosticInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id)
+{
+    tAESYS_MEP_GET_CMD diag_info[] = {
+                                       { .code = htons(MEP_CUSTOM_DIAGNOSTIC_INFO_DATA), .offset = 0, },
+                                       { .code = htons(MEP_DOORS_OPEN)                 , .offset = 0, },
+                                       { .code = htons(MEP_POWER_SAVING_STATUS)        , .offset = 0, },
+                                       { .code = htons(MEP_BATTERY_LEVEL)              , .offset = 0, },
+                                       { .code = htons(MEP_FANS_ACTIVE)                , .offset = 0, },
+                                       { .code = htons(MEP_SIREN_ACTIVE)               , .offset = 0, },
+                                       { .code = htons(MEP_HEATING_ACTIVE)             , .offset = 0, },
+                                       { .code = htons(MEP_BROKEN_FANS_NUMBER)         , .offset = 0, },
+                                       { .code = htons(MEP_BROKEN_BACKLIGHTS_NUMBER)   , .offset = 0, },
+                                       { .code = htons(MEP_INTERNAL_ERROR_CODE)        , .offset = 0, },
+                                       { .code = htons(MEP_NUM_BROKEN_LED_BOARDS)      , .offset = 0, },
+                                       { .code = htons(MEP_BROKEN_LEDS_NUMBER)         , .offset = 0, },
+                                    };
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof (diag_info),trans_id,MEP_GET,(uint8_t *) diag_info);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildDevRestartedInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id)
+{
+    tAESYS_MEP_GET_CMD dev_restarted = { .code = htons(MEP_DEVICE_RESTARTED), .offset = 0, };
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof (dev_restarted),trans_id,MEP_GET,(uint8_t *) &dev_restarted);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildLastPublicationInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id)
+{
+    tAESYS_MEP_GET_CMD pub_info = { .code = htons(MEP_REMEMBER_LAST_PUBLICATION), .offset = 0, };
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof (pub_info),trans_id,MEP_GET,(uint8_t *) &pub_info);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildTempInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t code)
+{
+    uint16_t temp_codes[] = {MEP_TEMP_1,MEP_TEMP_2,MEP_TEMP_3,MEP_TEMP_4,MEP_TEMP_5,MEP_TEMP_6,MEP_TEMP_7,MEP_TEMP_8};
+    tAESYS_MEP_GET_CMD temp_info[] = {
+                                       { .code = htons(MEP_CUSTOM_TEMPERATURE_INFO_DATA), .offset = 0, },
+                                       { .code = htons(temp_codes[0])                   , .offset = 0, },
+                                       { .code = htons(temp_codes[1])                   , .offset = 0, },
+                                       { .code = htons(temp_codes[2])                   , .offset = 0, },
+                                       { .code = htons(temp_codes[3])                   , .offset = 0, },
+                                       { .code = htons(temp_codes[4])                   , .offset = 0, },
+                                       { .code = htons(temp_codes[5])                   , .offset = 0, },
+                                       { .code = htons(temp_codes[6])                   , .offset = 0, },
+                                       { .code = htons(temp_codes[7])                   , .offset = 0, },
+                                    };
+
+    if (code != 0)
+    {
+        for (uint16_t i = 0, size = sizeof(temp_codes)/2; i < size; i++)
+        {
+             if (code == temp_codes[i])
+                 return createSendMEPFrame(output,type,0xFFFE,sizeof (tAESYS_MEP_GET_CMD),trans_id,MEP_GET,(uint8_t *)&temp_info[i+1]);
+        }
+
+        return NULL;
+    }
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof (temp_info),trans_id,MEP_GET,(uint8_t *) temp_info);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildHumidityInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t code)
+{
+    uint16_t hum_codes[] = {MEP_HUMIDITY_1,MEP_HUMIDITY_2,MEP_HUMIDITY_3,MEP_HUMIDITY_4};
+    tAESYS_MEP_GET_CMD hum_info[] = {
+                                       { .code = htons(MEP_CUSTOM_HUMIDITY_INFO_DATA), .offset = 0, },
+                                       { .code = htons(hum_codes[0])                 , .offset = 0, },
+                                       { .code = htons(hum_codes[1])                 , .offset = 0, },
+                                       { .code = htons(hum_codes[2])                 , .offset = 0, },
+                                       { .code = htons(hum_codes[3])                 , .offset = 0, },
+                                    };
+
+    if (code != 0)
+    {
+        for (uint16_t i = 0, size = sizeof(hum_codes)/2; i < size; i++)
+        {
+             if (code == hum_codes[i])
+                 return createSendMEPFrame(output,type,0xFFFE,sizeof (tAESYS_MEP_GET_CMD),trans_id,MEP_GET,(uint8_t *)&hum_info[i+1]);
+        }
+
+        return NULL;
+    }
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof (hum_info),trans_id,MEP_GET,(uint8_t *) hum_info);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildBrightnessInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t code)
+{
+    uint16_t bright_codes[] = {MEP_BRIGHTNESS_1,MEP_BRIGHTNESS_2,MEP_BRIGHTNESS_3,MEP_BRIGHTNESS_4};
+    tAESYS_MEP_GET_CMD bright_info[] = {
+                                         { .code = htons(MEP_CUSTOM_BRIGHTNESS_INFO_DATA), .offset = 0, },
+                                         { .code = htons(bright_codes[0])                , .offset = 0, },
+                                         { .code = htons(bright_codes[1])                , .offset = 0, },
+                                         { .code = htons(bright_codes[2])                , .offset = 0, },
+                                         { .code = htons(bright_codes[3])                , .offset = 0, },
+                                       };
+
+    if (code != 0)
+    {
+        for (uint16_t i = 0, size = sizeof(bright_codes)/2; i < size; i++)
+        {
+             if (code == bright_codes[i])
+                 return createSendMEPFrame(output,type,0xFFFE,sizeof (tAESYS_MEP_GET_CMD),trans_id,MEP_GET,(uint8_t *)&bright_info[i+1]);
+        }
+
+        return NULL;
+    }
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof (bright_info),trans_id,MEP_GET,(uint8_t *) bright_info);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildTrafficLightInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t code)
+{
+    uint16_t traffic_codes[] = {MEP_TRAFFIC_LIGHT_STATUS_1,MEP_TRAFFIC_LIGHT_STATUS_2,MEP_TRAFFIC_LIGHT_STATUS_3,MEP_TRAFFIC_LIGHT_STATUS_4};
+    tAESYS_MEP_GET_CMD traffic_info[] = {
+                                            { .code = htons(MEP_CUSTOM_TRAFFIC_INFO_DATA), .offset = 0, },
+                                            { .code = htons(traffic_codes[0])            , .offset = 0, },
+                                            { .code = htons(traffic_codes[1])            , .offset = 0, },
+                                            { .code = htons(traffic_codes[2])            , .offset = 0, },
+                                            { .code = htons(traffic_codes[3])            , .offset = 0, },
+                                        };
+
+    if (code != 0)
+    {
+        for (uint16_t i = 0, size = sizeof(traffic_codes)/2; i < size; i++)
+        {
+             if (code == traffic_codes[i])
+                 return createSendMEPFrame(output,type,0xFFFE,sizeof (tAESYS_MEP_GET_CMD),trans_id,MEP_GET,(uint8_t *)&traffic_info[i+1]);
+        }
+
+        return NULL;
+    }
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof (traffic_info),trans_id,MEP_GET,(uint8_t *) traffic_info);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildEnvBrightnessInfoMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t code)
+{
+    uint16_t ebright_codes[]             = { MEP_ENVIRONMENTAL_BRIGHTNESS_1,MEP_ENVIRONMENTAL_BRIGHTNESS_2,
+                                             MEP_ENVIRONMENTAL_BRIGHTNESS_3,MEP_ENVIRONMENTAL_BRIGHTNESS_4,
+                                             MEP_ENVIRONMENTAL_BRIGHTNESS_5,MEP_ENVIRONMENTAL_BRIGHTNESS_6,
+                                             MEP_ENVIRONMENTAL_BRIGHTNESS_7,MEP_ENVIRONMENTAL_BRIGHTNESS_8 };
+    tAESYS_MEP_GET_CMD env_bright_info[] = {
+                                              { .code = htons(MEP_CUSTOM_EBRIGHTNESS_INFO_DATA), .offset = 0, },
+                                              { .code = htons(ebright_codes[0])                , .offset = 0, },
+                                              { .code = htons(ebright_codes[1])                , .offset = 0, },
+                                              { .code = htons(ebright_codes[2])                , .offset = 0, },
+                                              { .code = htons(ebright_codes[3])                , .offset = 0, },
+                                              { .code = htons(ebright_codes[4])                , .offset = 0, },
+                                              { .code = htons(ebright_codes[5])                , .offset = 0, },
+                                              { .code = htons(ebright_codes[6])                , .offset = 0, },
+                                              { .code = htons(ebright_codes[7])                , .offset = 0, },
+                                           };
+
+    if (code != 0)
+    {
+        for (uint16_t i = 0, size = sizeof(ebright_codes)/2; i < size; i++)
+        {
+             if (code == ebright_codes[i])
+                 return createSendMEPFrame(output,type,0xFFFE,sizeof (tAESYS_MEP_GET_CMD),trans_id,MEP_GET,(uint8_t *)&env_bright_info[i+1]);
+        }
+
+        return NULL;
+    }
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof (env_bright_info),trans_id,MEP_GET,(uint8_t *) env_bright_info);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildNextGetMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t sentinel, const tAESYS_MEP_GET_CMD *cmds, uint16_t count, uint16_t *offset)
+{
+    const tAESYS_MEP_CODE_PROPERTIES *code_prop;
+    tAESYS_MEP_BUFFER *frame;
+    uint8_t  payload[K_MEP_MAX_DATA_SIZE], *cmd;
+    uint16_t dlen = 0, escaped = 0, next, esc, j;
+    uint16_t limit = (type == MEP_PPTP) ? K_MEP_MAX_DATA_SIZE : K_MEP_MAX_FRAME_SIZE - K_UPTB_HEAD_ESC;
+
+    if (cmds == NULL || offset == NULL || *offset >= count)
+        return NULL;
+
+    // The sentinel is the first code of every frame.
+    if (sentinel != 0)
+    {
+        payload[0] = sentinel >> 8;
+        payload[1] = sentinel & 0xFF;
+        memset(&payload[2],0,4);
+        dlen    = K_GET_CMD_SIZE;
+        escaped = (type == MEP_PPTP) ? K_GET_CMD_SIZE : K_GET_CMD_SIZE * 2;
+    }
+
+    for (next = *offset; next < count && dlen + K_GET_CMD_SIZE <= K_MEP_MAX_DATA_SIZE; next++)
+    {
+        // Only the codes that can be read.
+        code_prop = AesysMepGetCodeProperties(cmds[next].code);
+        if (code_prop != NULL && !(code_prop->iops & MEP_RD))
+            return NULL;
+
+        cmd    = &payload[dlen];
+        cmd[0] = cmds[next].code >> 8;
+        cmd[1] = cmds[next].code & 0xFF;
+        cmd[2] = cmds[next].offset >> 24;
+        cmd[3] = (cmds[next].offset >> 16) & 0xFF;
+        cmd[4] = (cmds[next].offset >> 8) & 0xFF;
+        cmd[5] = cmds[next].offset & 0xFF;
+
+        // In UoPTB frames every STX, ETX or DLE byte is escaped.
+        for (esc = K_GET_CMD_SIZE, j = 0; type != MEP_PPTP && j < K_GET_CMD_SIZE; j++)
+             if (cmd[j] == K_MEP_STX || cmd[j] == K_MEP_ETX || cmd[j] == K_MEP_DLE)
+                 esc++;
+
+        if (escaped + esc > limit)
+            break;
+
+        escaped += esc;
+        dlen    += K_GET_CMD_SIZE;
+    }
+
+    frame = createSendMEPFrame(output,type,0xFFFE,dlen,trans_id,MEP_GET,payload);
+
+    if (frame != NULL || (output != NULL && output->result == 1))
+        *offset = next;
+
+    return frame;
+}
+//---------------------------------------------------------------------
+/**********************************************************************
+*****                 Device manipulation section                 *****
+**********************************************************************/
+
+tAESYS_MEP_BUFFER * buildClearPublication(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id)
+{
+    uint8_t buffer[33];
+    tAESYS_MEP_SET_CMD commands[] = {
+                                      { .code = htons(MEP_CUSTOM_CLEAR_PUB), .offset = 0        , .length = 0        , .data = NULL, }, // Id cmd
+                                      { .code = htons(MEP_VIS_EXTENSIBLE)  , .offset = 0        , .length = 0        , .data = NULL, }, // Nice-start.
+                                      { .code = htons(MEP_VIS_EXTENSIBLE)  , .offset = 0        , .length = htons(1) , .data = NULL, }, // Text Msg data.
+                                      { .code = htons(MEP_VIS_EXTENSIBLE)  , .offset = htonl(1) , .length = 0        , .data = NULL, }, // Nice-end.
+                                    };
+
+    buffer[24] = 0x00; // Set clear publication byte.
+    memcpy(&buffer[0] ,(uint8_t *)&commands[0],8);
+    memcpy(&buffer[8] ,(uint8_t *)&commands[1],8);
+    memcpy(&buffer[16],(uint8_t *)&commands[2],8);
+    memcpy(&buffer[25],(uint8_t *)&commands[3],8);
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof(buffer),trans_id,MEP_SET,buffer);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildResetDeviceMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id)
+{
+    tAESYS_MEP_SET_CMD command = { .code = htons(MEP_RESET), .offset = 0x00, .length = 0x00, .data = NULL, };
+
+    return createSendMEPFrame(output,type,0xFFFE,8,trans_id,MEP_SET,(uint8_t *)&command);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildDelCode(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t code)
+{
+    uint8_t buffer[4] = {0xFD,0xEC,0x00,0x00};
+    const tAESYS_MEP_CODE_PROPERTIES *prop = AesysMepGetCodeProperties(code);
+
+    if (prop == NULL || prop->iops == 1)
+        return NULL;
+
+    code = htons(code);
+    memcpy(&buffer[2],&code,2);
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof(buffer),trans_id,MEP_DEL,buffer);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildSetMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t sentinel, const tAESYS_MEP_SET_CMD *cmds, uint16_t count)
+{
+    // Data length of each MEP type. K_ANY_SIZE for binary and strings.
+    const uint8_t type_sizes[] = {0,1,1,2,4,1,2,4,K_ANY_SIZE,K_ANY_SIZE,K_ANY_SIZE};
+    const tAESYS_MEP_CODE_PROPERTIES *code_prop;
+    uint8_t  payload[K_MEP_MAX_DATA_SIZE], *cmd;
+    uint16_t dlen = 0, i;
+
+    if (cmds == NULL || count == 0)
+        return NULL;
+
+    // The sentinel is a SET command without data.
+    if (sentinel != 0)
+    {
+        payload[0] = sentinel >> 8;
+        payload[1] = sentinel & 0xFF;
+        memset(&payload[2],0,6);
+        dlen = K_SET_CMD_SIZE;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        // Only the codes supported by this library that can be written and with the size of its type.
+        code_prop = AesysMepGetCodeProperties(cmds[i].code);
+        if (code_prop == NULL || !(code_prop->iops & MEP_WR))
+            return NULL;
+        if (type_sizes[code_prop->type] != K_ANY_SIZE && type_sizes[code_prop->type] != cmds[i].length)
+            return NULL;
+        if ((cmds[i].length && cmds[i].data == NULL) || dlen + K_SET_CMD_SIZE + cmds[i].length > K_MEP_MAX_DATA_SIZE)
+            return NULL;
+
+        cmd    = &payload[dlen];
+        cmd[0] = cmds[i].code >> 8;
+        cmd[1] = cmds[i].code & 0xFF;
+        cmd[2] = cmds[i].offset >> 24;
+        cmd[3] = (cmds[i].offset >> 16) & 0xFF;
+        cmd[4] = (cmds[i].offset >> 8) & 0xFF;
+        cmd[5] = cmds[i].offset & 0xFF;
+        cmd[6] = cmds[i].length >> 8;
+        cmd[7] = cmds[i].length & 0xFF;
+
+        if (cmds[i].length)
+            memcpy(&cmd[K_SET_CMD_SIZE],cmds[i].data,cmds[i].length);
+
+        dlen += K_SET_CMD_SIZE + cmds[i].length;
+    }
+
+    return createSendMEPFrame(output,type,0xFFFE,dlen,trans_id,MEP_SET,payload);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildClockMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint8_t *clock)
+{
+    uint8_t buffer[14];
+    uint8_t days_per_month[]   = {31,29,31,30,31,30,31,31,30,31,30,31};
+    tAESYS_MEP_SET_CMD command = { .code = htons(MEP_CLOCK), .offset = 0, .length = htons(6), .data = clock, };
+
+    // Validating CLOCK values. Remember format is ymdhms
+    if (clock == NULL || clock[1] == 0 || clock[1] > 12 || clock[2] == 0 ||
+        clock[2] > days_per_month[clock[1]-1] || clock[3] > 24 || clock[4] > 59 || clock[5] > 59)
+        return NULL;
+
+    memcpy(&buffer[0],(uint8_t *)&command,8);
+    memcpy(&buffer[8],clock,6);
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof(buffer),trans_id,MEP_SET,buffer);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildBrightnessMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t values[])
+{
+    uint16_t offset = 8;
+    uint8_t buffer[44] = {0};
+    tAESYS_MEP_SET_CMD commands[] = {
+                                       { .code = htons(MEP_CUSTOM_SET_BRIGHTNESS), .offset = 0, .length = 0       , .data = NULL, },
+                                       { .code = htons(MEP_BRIGHTNESS_1)         , .offset = 0, .length = htons(1), .data = NULL, },
+                                       { .code = htons(MEP_BRIGHTNESS_2)         , .offset = 0, .length = htons(1), .data = NULL, },
+                                       { .code = htons(MEP_BRIGHTNESS_3)         , .offset = 0, .length = htons(1), .data = NULL, },
+                                       { .code = htons(MEP_BRIGHTNESS_4)         , .offset = 0, .length = htons(1), .data = NULL, },
+                                    };
+
+    if (values == NULL)
+        return NULL;
+
+    memcpy(&buffer[0],(uint8_t *)&commands[0],8);
+    for (uint16_t i = 0, j = 1; i < 4; i++, j++)
+    {
+         if (values[i] <= 255)
+         {
+             memcpy(&buffer[offset],(uint8_t *)&commands[j],8);
+             buffer[offset+8] = values[i];
+             offset += 9;
+         }
+    }
+
+    if (offset == 8)
+        return NULL;
+
+    return createSendMEPFrame(output,type,0xFFFE,offset,trans_id,MEP_SET,buffer);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildLastPublicationStatusMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint8_t status)
+{
+    uint8_t buffer[9];
+    tAESYS_MEP_SET_CMD command = { .code = htons(MEP_REMEMBER_LAST_PUBLICATION), .offset = 0, .length = htons(1), .data = NULL, };
+
+    memcpy(&buffer[0],(uint8_t *)&command,8);
+    buffer[8] = (status) ? 1 : 0;
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof(buffer),trans_id,MEP_SET,buffer);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildDeviceIdMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t size, const char *strId)
+{
+    uint8_t buffer[32] = {0};
+    size = (size > 16) ? 16 : size;
+    tAESYS_MEP_SET_CMD commands[] = {
+                                       { .code = htons(MEP_CUSTOM_SET_DEVID), .offset = 0, .length = 0          , .data = NULL, },
+                                       { .code = htons(MEP_DEVICE_ID)       , .offset = 0, .length = htons(size), .data = NULL, }
+                                    };
+
+    if (strId == NULL)
+        return NULL;
+
+    memcpy(&buffer[0],(uint8_t *)&commands[0],8);
+    memcpy(&buffer[8],(uint8_t *)&commands[1],8);
+    memcpy(&buffer[16],strId,size);
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof(buffer),trans_id,MEP_SET,buffer);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildDeviceDescMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t size, const char *desc)
+{
+    uint8_t buffer[80] = {0};
+    size = (size > 64) ? 64 : size;
+    tAESYS_MEP_SET_CMD commands[] = {
+                                       { .code = htons(MEP_CUSTOM_SET_DEVDESC), .offset = 0, .length = 0          , .data = NULL, },
+                                       { .code = htons(MEP_DEVICE_DESCRIPTION), .offset = 0, .length = htons(size), .data = NULL, }
+                                    };
+
+    if (desc == NULL)
+        return NULL;
+
+    memcpy(&buffer[0],(uint8_t *)&commands[0],8);
+    memcpy(&buffer[8],(uint8_t *)&commands[1],8);
+    memcpy(&buffer[16],desc,size);
+
+    return createSendMEPFrame(output,type,0xFFFE,sizeof(buffer),trans_id,MEP_SET,buffer);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildTrafficLightStatusMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t code, uint16_t value)
+{
+    uint8_t byte;
+    uint8_t buffer[18];
+    tAESYS_MEP_SET_CMD commands[] = {
+                                       { .code = htons(MEP_CUSTOM_SET_TRAFFIC), .offset = 0, .length = 0       , .data = NULL },
+                                       { .code = htons(code)                  , .offset = 0, .length = htons(2), .data = NULL }
+                                    };
+
+    if (code >= 0x814C && code <= 0x814F)
+    {
+        memcpy(&buffer[0],(uint8_t *)&commands[0],8);
+        memcpy(&buffer[8],(uint8_t *)&commands[1],8);
+
+        byte = (value >> 8) & 0x07;
+        if (byte != 1 && byte != 2 && byte != 4)
+            return NULL;
+
+        buffer[16] = byte;
+
+        byte = value & 0x07;
+        if (byte != 1 && byte != 2 && byte != 4)
+            return NULL;
+
+        buffer[17] = byte;
+
+        return createSendMEPFrame(output,type,0xFFFE,sizeof(buffer),trans_id,MEP_SET,buffer);
+    }
+
+    return NULL;
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildPictogramMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint8_t flashing_lamps, uint16_t picto_code)
+{
+    tAESYS_MEP_PUB_PAGE page = { .type = MEP_PAGE_PICTO, .duration = 0x05, .params = 0x00, .picto_code = picto_code, .msg = NULL, };
+
+    page.params = (flashing_lamps) ? 1 : 0;
+
+    return buildPublicationMsg(output,type,trans_id,MEP_CUSTOM_SET_PICTO,1,&page,NULL);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildTextMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint8_t size, const tAESYS_MEP_MSG_DATA *msg, const tAESYS_MEP_PANEL_DATA *panel, tAESYS_MEP_TEXT_SPAN *spans)
+{
+    int psize = 0;
+    uint16_t offset = 27;
+    char vis_h[3] = {0x01,0x00,0x01};
+    tAESYS_MEP_VIS_EXT_PAGE page;
+    uint8_t buffer[K_MEP_MAX_DATA_SIZE];
+    tAESYS_MEP_SET_CMD commands[]   = {
+                                         { .code = htons(MEP_CUSTOM_SET_TEXT), .offset = 0, .length = 0, .data = NULL, }, // Id cmd
+                                         { .code = htons(MEP_VIS_EXTENSIBLE) , .offset = 0, .length = 0, .data = NULL, }, // Nice-start.
+                                         { .code = htons(MEP_VIS_EXTENSIBLE) , .offset = 0, .length = 0, .data = NULL, }, // Text Msg data.
+                                         { .code = htons(MEP_VIS_EXTENSIBLE) , .offset = 0, .length = 0, .data = NULL, }, // Nice-end.
+                                      };
+
+    // Check for invalid parameters
+    if (msg == NULL || panel == NULL || size == 0 || panel->font_size[0] == 0 || panel->font_size[1] == 0)
+        return NULL;
+
+    // The buffer is not initialized: every byte up to offset is written below.
+    vis_h[2] = size;
+    memcpy(&buffer[0] ,(uint8_t *)&commands[0],8);
+    memcpy(&buffer[8] ,(uint8_t *)&commands[1],8);
+    memcpy(&buffer[24],vis_h,3);
+
+    for (uint8_t p = 0; p < size; p++)
+    {
+         // Without room for the page the frame is not valid.
+         if (offset+5 > K_MEP_MAX_DATA_SIZE)
+         {
+             psize = -1;
+             break;
+         }
+
+         offset+= 5;
+         if (msg[p].rows == NULL || msg[p].total_rows == 0)
+         {
+             // The page without rows is sent empty.
+             memset(&buffer[offset-5],0,5);
+             break;
+         }
+
+         page.duration = (msg[p].duration == 0) ? 1 : msg[p].duration;
+         page.params   = msg[p].parameters & 3;
+         page.type     = 0;
+
+         if ((psize = addTextProperties(buffer,&offset,&msg[p],panel,spans)) == -1)
+             break;
+
+         // The spans of the rows of each page are consecutive.
+         if (spans != NULL)
+             spans += msg[p].total_rows;
+
+         page.size     = htons(psize);
+         memcpy(&buffer[offset-psize-5],(uint8_t *)&page,5);
+    }
+
+    if (psize == -1 || offset+8 > K_MEP_MAX_DATA_SIZE)
+        return NULL;
+
+    commands[2].length = htons(offset-24);
+    commands[3].offset = htonl(offset-24);
+
+    // Add the VISEXT for MSG and nice-end
+    memcpy(&buffer[16],(uint8_t *)&commands[2],8);
+    memcpy(&buffer[offset] ,(uint8_t *)&commands[3],8);
+    offset += 8;
+
+    return createSendMEPFrame(output,type,0xFFFE,offset,trans_id,MEP_SET,buffer);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * buildPublicationMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint16_t trans_id, uint16_t id, uint8_t size, const tAESYS_MEP_PUB_PAGE *pages, const tAESYS_MEP_PANEL_DATA *panel)
+{
+    int psize;
+    uint16_t offset = 27, start;
+    uint8_t buffer[K_MEP_MAX_DATA_SIZE];
+    tAESYS_MEP_SET_CMD commands[]   = {
+                                         { .code = htons(id)                , .offset = 0, .length = 0, .data = NULL, }, // Id cmd
+                                         { .code = htons(MEP_VIS_EXTENSIBLE), .offset = 0, .length = 0, .data = NULL, }, // Nice-start.
+                                         { .code = htons(MEP_VIS_EXTENSIBLE), .offset = 0, .length = 0, .data = NULL, }, // Publication data.
+                                         { .code = htons(MEP_VIS_EXTENSIBLE), .offset = 0, .length = 0, .data = NULL, }, // Nice-end.
+                                      };
+
+    // Check for invalid parameters
+    if (pages == NULL || size == 0)
+        return NULL;
+
+    memcpy(&buffer[0] ,(uint8_t *)&commands[0],8);
+    memcpy(&buffer[8] ,(uint8_t *)&commands[1],8);
+    buffer[24] = 0x01;
+    buffer[25] = 0x00;
+    buffer[26] = size;
+
+    for (uint8_t p = 0; p < size; p++)
+    {
+         // The page header is written after the page definition.
+         start   = offset;
+         offset += 5;
+
+         if (pages[p].type == MEP_PAGE_PICTO)
+         {
+             if (offset+2 > K_MEP_MAX_DATA_SIZE)
+                 return NULL;
+
+             buffer[offset++] = pages[p].picto_code >> 8;
+             buffer[offset++] = pages[p].picto_code & 0xFF;
+             psize = 2;
+         }
+         else if (pages[p].type == MEP_PAGE_TEXT)
+         {
+             if (pages[p].msg == NULL || pages[p].msg->rows == NULL || pages[p].msg->total_rows == 0 ||
+                 panel == NULL || panel->font_size[0] == 0 || panel->font_size[1] == 0 || offset > K_MEP_MAX_DATA_SIZE)
+                 return NULL;
+
+             if ((psize = addTextProperties(buffer,&offset,pages[p].msg,panel,NULL)) == -1)
+                 return NULL;
+         }
+         else
+             return NULL;
+
+         buffer[start]   = (pages[p].duration == 0) ? 1 : pages[p].duration;
+         buffer[start+1] = pages[p].params & 3;
+         buffer[start+2] = pages[p].type;
+         buffer[start+3] = psize >> 8;
+         buffer[start+4] = psize & 0xFF;
+    }
+
+    if (offset+8 > K_MEP_MAX_DATA_SIZE)
+        return NULL;
+
+    commands[2].length = htons(offset-24);
+    commands[3].offset = htonl(offset-24);
+
+    // Add the VISEXT for publication and nice-end
+    memcpy(&buffer[16],(uint8_t *)&commands[2],8);
+    memcpy(&buffer[offset] ,(uint8_t *)&commands[3],8);
+    offset += 8;
+
+    return createSendMEPFrame(output,type,0xFFFE,offset,trans_id,MEP_SET,buffer);
+}
+//---------------------------------------------------------------------
+/**********************************************************************
+*****                 Allocated buffer section                    *****
+**********************************************************************/
+
+tAESYS_MEP_BUFFER * AesysMepBuildClockInfoMsg(uint8_t type, uint16_t trans_id)
+{
+    return buildClockInfoMsg(NULL,type,trans_id);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildDeviceInfoMsg(uint8_t type, uint16_t trans_id)
+{
+    return buildDeviceInfoMsg(NULL,type,trans_id);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildDevStatusInfoMsg(uint8_t type, uint16_t trans_id)
+{
+    return buildDevStatusInfoMsg(NULL,type,trans_id);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildDiagnosticInfoMsg(uint8_t type, uint16_t trans_id)
+{
+    return buildDiagnosticInfoMsg(NULL,type,trans_id);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildDevRestartedInfoMsg(uint8_t type, uint16_t trans_id)
+{
+    return buildDevRestartedInfoMsg(NULL,type,trans_id);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildLastPublicationInfoMsg(uint8_t type, uint16_t trans_id)
+{
+    return buildLastPublicationInfoMsg(NULL,type,trans_id);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildTempInfoMsg(uint8_t type, uint16_t trans_id, uint16_t code)
+{
+    return buildTempInfoMsg(NULL,type,trans_id,code);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildHumidityInfoMsg(uint8_t type, uint16_t trans_id, uint16_t code)
+{
+    return buildHumidityInfoMsg(NULL,type,trans_id,code);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildBrightnessInfoMsg(uint8_t type, uint16_t trans_id, uint16_t code)
+{
+    return buildBrightnessInfoMsg(NULL,type,trans_id,code);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildTrafficLightInfoMsg(uint8_t type, uint16_t trans_id, uint16_t code)
+{
+    return buildTrafficLightInfoMsg(NULL,type,trans_id,code);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildEnvBrightnessInfoMsg(uint8_t type, uint16_t trans_id, uint16_t code)
+{
+    return buildEnvBrightnessInfoMsg(NULL,type,trans_id,code);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildNextGetMsg(uint8_t type, uint16_t trans_id, uint16_t sentinel, const tAESYS_MEP_GET_CMD *cmds, uint16_t count, uint16_t *offset)
+{
+    return buildNextGetMsg(NULL,type,trans_id,sentinel,cmds,count,offset);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildClearPublication(uint8_t type, uint16_t trans_id)
+{
+    return buildClearPublication(NULL,type,trans_id);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildResetDeviceMsg(uint8_t type, uint16_t trans_id)
+{
+    return buildResetDeviceMsg(NULL,type,trans_id);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildDelCode(uint8_t type, uint16_t trans_id, uint16_t code)
+{
+    return buildDelCode(NULL,type,trans_id,code);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildSetMsg(uint8_t type, uint16_t trans_id, uint16_t sentinel, const tAESYS_MEP_SET_CMD *cmds, uint16_t count)
+{
+    return buildSetMsg(NULL,type,trans_id,sentinel,cmds,count);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildClockMsg(uint8_t type, uint16_t trans_id, uint8_t *clock)
+{
+    return buildClockMsg(NULL,type,trans_id,clock);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildBrightnessMsg(uint8_t type, uint16_t trans_id, uint16_t values[])
+{
+    return buildBrightnessMsg(NULL,type,trans_id,values);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildLastPublicationStatusMsg(uint8_t type, uint16_t trans_id, uint8_t status)
+{
+    return buildLastPublicationStatusMsg(NULL,type,trans_id,status);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildDeviceIdMsg(uint8_t type, uint16_t trans_id, uint16_t size, const char *strId)
+{
+    return buildDeviceIdMsg(NULL,type,trans_id,size,strId);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildDeviceDescMsg(uint8_t type, uint16_t trans_id, uint16_t size, const char *desc)
+{
+    return buildDeviceDescMsg(NULL,type,trans_id,size,desc);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildTrafficLightStatusMsg(uint8_t type, uint16_t trans_id, uint16_t code, uint16_t value)
+{
+    return buildTrafficLightStatusMsg(NULL,type,trans_id,code,value);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildPictogramMsg(uint8_t type, uint16_t trans_id, uint8_t flashing_lamps, uint16_t picto_code)
+{
+    return buildPictogramMsg(NULL,type,trans_id,flashing_lamps,picto_code);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildTextMsg(uint8_t type, uint16_t trans_id, uint8_t size, const tAESYS_MEP_MSG_DATA *msg, const tAESYS_MEP_PANEL_DATA *panel)
+{
+    return buildTextMsg(NULL,type,trans_id,size,msg,panel,NULL);
+}
+//---------------------------------------------------------------------
+
+tAESYS_MEP_BUFFER * AesysMepBuildPublicationMsg(uint8_t type, uint16_t trans_id, uint8_t size, const tAESYS_MEP_PUB_PAGE *pages, const tAESYS_MEP_PANEL_DATA *panel)
+{
+    return buildPublicationMsg(NULL,type,trans_id,MEP_CUSTOM_SET_PUBLICATION,size,pages,panel);
+}
+//---------------------------------------------------------------------
+
+/**********************************************************************
+*****                  Caller buffer section                      *****
+**********************************************************************/
+
+uint16_t AesysMepGetMaxFrameSize(uint8_t type, uint16_t dlen)
+{
+    uint16_t size = 5 + dlen;
+
+    if (type > 2 || dlen > K_MEP_MAX_DATA_SIZE)
+        return 0;
+
+    if (type == MEP_PPTP)
+        return size;
+
+    // Address and CRC, every byte escaped in the worst case.
+    size = (size+4 > K_MEP_MAX_FRAME_SIZE/2) ? K_MEP_MAX_FRAME_SIZE : (size+4)*2;
+
+    return size + ((type == MEP_UPTB) ? 2 : 0);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildClockInfoMsgTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildClockInfoMsg(&output,type,trans_id);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildDeviceInfoMsgTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildDeviceInfoMsg(&output,type,trans_id);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildDevStatusInfoMsgTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildDevStatusInfoMsg(&output,type,trans_id);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildDiagnosticInfoMsgTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildDiagnosticInfoMsg(&output,type,trans_id);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildDevRestartedInfoMsgTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildDevRestartedInfoMsg(&output,type,trans_id);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildLastPublicationInfoMsgTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildLastPublicationInfoMsg(&output,type,trans_id);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildTempInfoMsgTo(uint8_t type, uint16_t trans_id, uint16_t code, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildTempInfoMsg(&output,type,trans_id,code);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildHumidityInfoMsgTo(uint8_t type, uint16_t trans_id, uint16_t code, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildHumidityInfoMsg(&output,type,trans_id,code);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildBrightnessInfoMsgTo(uint8_t type, uint16_t trans_id, uint16_t code, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildBrightnessInfoMsg(&output,type,trans_id,code);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildTrafficLightInfoMsgTo(uint8_t type, uint16_t trans_id, uint16_t code, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildTrafficLightInfoMsg(&output,type,trans_id,code);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildEnvBrightnessInfoMsgTo(uint8_t type, uint16_t trans_id, uint16_t code, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildEnvBrightnessInfoMsg(&output,type,trans_id,code);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildNextGetMsgTo(uint8_t type, uint16_t trans_id, uint16_t sentinel, const tAESYS_MEP_GET_CMD *cmds, uint16_t count, uint16_t *offset, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildNextGetMsg(&output,type,trans_id,sentinel,cmds,count,offset);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildClearPublicationTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildClearPublication(&output,type,trans_id);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildResetDeviceMsgTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildResetDeviceMsg(&output,type,trans_id);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildDelCodeTo(uint8_t type, uint16_t trans_id, uint16_t code, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildDelCode(&output,type,trans_id,code);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildSetMsgTo(uint8_t type, uint16_t trans_id, uint16_t sentinel, const tAESYS_MEP_SET_CMD *cmds, uint16_t count, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildSetMsg(&output,type,trans_id,sentinel,cmds,count);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildClockMsgTo(uint8_t type, uint16_t trans_id, uint8_t *clock, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildClockMsg(&output,type,trans_id,clock);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildBrightnessMsgTo(uint8_t type, uint16_t trans_id, uint16_t values[], uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildBrightnessMsg(&output,type,trans_id,values);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildLastPublicationStatusMsgTo(uint8_t type, uint16_t trans_id, uint8_t status, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildLastPublicationStatusMsg(&output,type,trans_id,status);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildDeviceIdMsgTo(uint8_t type, uint16_t trans_id, uint16_t size, const char *strId, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildDeviceIdMsg(&output,type,trans_id,size,strId);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildDeviceDescMsgTo(uint8_t type, uint16_t trans_id, uint16_t size, const char *desc, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildDeviceDescMsg(&output,type,trans_id,size,desc);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildTrafficLightStatusMsgTo(uint8_t type, uint16_t trans_id, uint16_t code, uint16_t value, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildTrafficLightStatusMsg(&output,type,trans_id,code,value);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildPictogramMsgTo(uint8_t type, uint16_t trans_id, uint8_t flashing_lamps, uint16_t picto_code, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildPictogramMsg(&output,type,trans_id,flashing_lamps,picto_code);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildTextMsgTo(uint8_t type, uint16_t trans_id, uint8_t size, const tAESYS_MEP_MSG_DATA *msg, const tAESYS_MEP_PANEL_DATA *panel, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildTextMsg(&output,type,trans_id,size,msg,panel,NULL);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+char AesysMepBuildPublicationMsgTo(uint8_t type, uint16_t trans_id, uint8_t size, const tAESYS_MEP_PUB_PAGE *pages, const tAESYS_MEP_PANEL_DATA *panel, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
+
+    buildPublicationMsg(&output,type,trans_id,MEP_CUSTOM_SET_PUBLICATION,size,pages,panel);
+
+    return setOutputSize(&output,b_size);
+}
+//---------------------------------------------------------------------
+
+/**********************************************************************
+*****                    Frame template section                   *****
+**********************************************************************/
+
+tAESYS_MEP_FRAME_TEMPLATE * AesysMepCreateFrameTemplate(const uint8_t *frame, uint16_t frame_size, uint8_t type, uint16_t addr)
+{
+    tAESYS_MEP_PPTP_VIEW view;
+    tAESYS_MEP_FRAME_TEMPLATE *tmpl = NULL;
+    uint8_t *decoded = NULL, *wrapped = NULL, *raw;
+    uint16_t dlen, offset, i;
+
+    if (frame == NULL || type > 2 || frame_size > K_MEP_MAX_FRAME_SIZE)
+        return NULL;
+
+    tmpl = (tAESYS_MEP_FRAME_TEMPLATE *) calloc(1,sizeof(tAESYS_MEP_FRAME_TEMPLATE));
+    if (tmpl == NULL)
+        goto TEMPLATE_ERROR;
+
+    tmpl->type = type;
+
+    // The PPTP frames only change the transaction id.
+    if (type == MEP_PPTP)
+    {
+        tmpl->data = (uint8_t *) malloc(frame_size);
+        if (tmpl->data == NULL)
+            goto TEMPLATE_ERROR;
+
+        memcpy(tmpl->data,frame,frame_size);
+        if (!AesysMepViewPPTPFrame(tmpl->data,frame_size,&view))
+            goto TEMPLATE_ERROR;
+
+        tmpl->size = frame_size;
+
+        return tmpl;
+    }
+
+    // The UoPTB frames without STX/ETX are decoded as a complete frame.
+    if (type == MEP_UPTBNTX)
+    {
+        wrapped = (uint8_t *) malloc(frame_size+2);
+        if (wrapped == NULL)
+            goto TEMPLATE_ERROR;
+
+        wrapped[0] = K_MEP_STX;
+        memcpy(&wrapped[1],frame,frame_size);
+        wrapped[frame_size+1] = K_MEP_ETX;
+        frame       = wrapped;
+        frame_size += 2;
+    }
+
+    if ((decoded = AesysMepDecodeUPTBFrame(frame,frame_size)) == NULL)
+        goto TEMPLATE_ERROR;
+
+    // The frame without escape, CRC and with transaction 0. ADDR,DLEN,TRAN,CMD,DATA.
+    dlen   = ((tAESYS_MEP_UPTB_FRAME *) decoded)->pptp.dlen;
+    raw    = &decoded[2];
+    raw[0] = addr >> 8;
+    raw[1] = addr & 0xFF;
+    raw[2] = dlen >> 8;
+    raw[3] = dlen & 0xFF;
+    raw[4] = raw[5] = 0;
+
+    // The CRC is linear, so the CRC of any transaction id is the CRC with
+    // transaction 0 xor the change produced by each bit set in the id.
+    tmpl->crc = calculateCRC(raw,dlen+7,0xFFFF);
+    for (i = 0; i < 16; i++)
+    {
+         raw[4] = (1 << i) >> 8;
+         raw[5] = (1 << i) & 0xFF;
+         tmpl->crc_tran[i] = calculateCRC(raw,dlen+7,0xFFFF) ^ tmpl->crc;
+    }
+
+    // STX, ADDR and DLEN escaped.
+    offset         = (type == MEP_UPTB) ? 1 : 0;
+    tmpl->head[0]  = K_MEP_STX;
+    encodeToUPTBFrame(raw,4,tmpl->head,sizeof(tmpl->head),&offset,NULL);
+    tmpl->head_size = offset;
+
+    // CMD and DATA escaped after the room for the head and the transaction id escaped.
+    // At the end the room for the CRC escaped and ETX.
+    tmpl->start = tmpl->head_size + 4;
+    tmpl->data  = (uint8_t *) malloc(tmpl->start + (dlen+1)*2 + 5);
+    if (tmpl->data == NULL)
+        goto TEMPLATE_ERROR;
+
+    offset = tmpl->start;
+    encodeToUPTBFrame(&raw[6],dlen+1,tmpl->data,tmpl->start+(dlen+1)*2,&offset,NULL);
+    tmpl->size = offset;
+
+    free(decoded);
+    free(wrapped);
+
+    return tmpl;
+
+    TEMPLATE_ERROR:
+
+    free(decoded);
+    free(wrapped);
+    AesysMepFreeFrameTemplate(tmpl);
+
+    return NULL;
 }
 //---------------------------------------------------------------------
-/**********************************************************************
-*****                     Device Info section                     *****
-**********************************************************************/
 
-tAESYS_MEP_BUFFER * AesysMepBuildClockInfoMsg(uint8_t type, uint16_t trans_id)
+const uint8_t * AesysMepPatchFrameTemplate(tAESYS_MEP_FRAME_TEMPLATE *tmpl, uint16_t trans_id, uint16_t *size)
 {
-    tAESYS_MEP_GET_CMD clock_info = { .code = htons(MEP_CLOCK), .offset = 0, };
+    uint8_t  tran[4];
+    uint16_t crc, start, offset;
+
+    if (tmpl == NULL || size == NULL)
+        return NULL;
+
+    if (tmpl->type == MEP_PPTP)
+    {
+        tmpl->data[2] = trans_id >> 8;
+        tmpl->data[3] = trans_id & 0xFF;
+        *size = tmpl->size;
+
+        return tmpl->data;
+    }
+
+    // The transaction id escaped ends where the data starts and the head is before.
+    offset = escapeWord(trans_id,tran);
+    start  = tmpl->start - offset - tmpl->head_size;
+    memcpy(&tmpl->data[start],tmpl->head,tmpl->head_size);
+    memcpy(&tmpl->data[tmpl->start-offset],tran,offset);
+
+    // The CRC is linear: add the change of each bit set. Masks avoid a branch per bit.
+    crc = tmpl->crc;
+    for (uint8_t i = 0; i < 16; i++)
+         crc ^= tmpl->crc_tran[i] & (uint16_t) -((trans_id >> i) & 1);
+
+    offset = tmpl->size + escapeWord(crc,&tmpl->data[tmpl->size]);
 
-    return createSendMEPFrame(type,0xFFFE,sizeof (clock_info),trans_id,MEP_GET,(uint8_t *) &clock_info);
+    if (tmpl->type == MEP_UPTB)
+        tmpl->data[offset++] = K_MEP_ETX;
+
+    *size = offset - start;
+
+    return &tmpl->data[start];
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildDeviceInfoMsg(uint8_t type, uint16_t trans_id)
+uint16_t escapedPosition(const tAESYS_MEP_FRAME_TEMPLATE *tmpl, uint16_t raw)
 {
-    tAESYS_MEP_GET_CMD hw_info[] = {
-                                      { .code = htons(MEP_CUSTOM_DEVICE_INFO_DATA), .offset = 0, },
-                                      { .code = htons(MEP_HARDWARE_MODEL)         , .offset = 0, },
-                                      { .code = htons(MEP_FIRMWARE_MODEL)         , .offset = 0, },
-                                      { .code = htons(MEP_FIRMWARE_VERSION)       , .offset = 0, },
-                                      { .code = htons(MEP_FIRMWARE_RELEASE)       , .offset = 0, },
-                                      { .code = htons(MEP_FIRMWARE_DEVICE_TYPE)   , .offset = 0, },
-                                      { .code = htons(MEP_DEVICE_ID)              , .offset = 0, },
-                                      { .code = htons(MEP_DEVICE_DESCRIPTION)     , .offset = 0, },
-                                  };
+    uint16_t pos = tmpl->start;
+
+    // The raw position 0 is the CMD. Each escaped byte uses 2 bytes.
+    for (; raw > 0 && pos < tmpl->size; raw--)
+         pos += (tmpl->data[pos] == K_MEP_DLE) ? 2 : 1;
 
-    return createSendMEPFrame(type,0xFFFE,sizeof (hw_info),trans_id,MEP_GET,(uint8_t *) hw_info);
+    return pos;
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildDevStatusInfoMsg(uint8_t type, uint16_t trans_id)
+tAESYS_MEP_TEXT_TEMPLATE * AesysMepCreateTextTemplate(uint8_t type, uint8_t size, const tAESYS_MEP_MSG_DATA *msg, const tAESYS_MEP_PANEL_DATA *panel, const tAESYS_MEP_TEXT_SLOT *slots, uint8_t count)
 {
-    tAESYS_MEP_GET_CMD dev_status [] = {
-                                         { .code = htons(MEP_CUSTOM_STATUS_INFO_DATA), .offset = 0, },
-                                         { .code = htons(MEP_STATUS)                 , .offset = 0, },
-                                       };
+    tAESYS_MEP_BUFFER *frame = NULL;
+    tAESYS_MEP_TEXT_SPAN *spans = NULL, *span;
+    tAESYS_MEP_TEXT_TEMPLATE *tmpl = NULL;
+    tAESYS_MEP_TEXT_TEMPLATE_SLOT *slot;
+    uint32_t rows = 0, first, chars = 0;
+    uint16_t crc, zeros, pos;
+    uint8_t  pages = 0, i, b, c;
+
+    if (msg == NULL || size == 0 || (slots == NULL && count != 0))
+        return NULL;
+
+    // The pages sent are the pages until the first one without rows.
+    for (; pages < size && msg[pages].rows != NULL && msg[pages].total_rows != 0; pages++)
+         rows += msg[pages].total_rows;
+
+    for (i = 0; i < count; i++)
+         chars += slots[i].width;
+
+    spans = (tAESYS_MEP_TEXT_SPAN *) calloc(rows+1,sizeof(tAESYS_MEP_TEXT_SPAN));
+    if (spans == NULL)
+        goto TEXT_TEMPLATE_ERROR;
+
+    if ((frame = buildTextMsg(NULL,type,0,size,msg,panel,spans)) == NULL)
+        goto TEXT_TEMPLATE_ERROR;
+
+    tmpl = (tAESYS_MEP_TEXT_TEMPLATE *) calloc(1,sizeof(tAESYS_MEP_TEXT_TEMPLATE));
+    if (tmpl == NULL)
+        goto TEXT_TEMPLATE_ERROR;
+
+    tmpl->frame    = AesysMepCreateFrameTemplate(frame->data,frame->size,type,0xFFFE);
+    tmpl->slots    = (tAESYS_MEP_TEXT_TEMPLATE_SLOT *) calloc(count+1,sizeof(tAESYS_MEP_TEXT_TEMPLATE_SLOT));
+    tmpl->crc_bits = (uint16_t *) malloc((chars+1)*8*sizeof(uint16_t));
+    if (tmpl->frame == NULL || tmpl->slots == NULL || tmpl->crc_bits == NULL)
+        goto TEXT_TEMPLATE_ERROR;
+
+    for (i = 0, chars = 0; i < count; i++)
+    {
+         slot = &tmpl->slots[i];
+
+         if (slots[i].name == NULL || strlen(slots[i].name) >= K_MEP_SLOT_NAME_SIZE ||
+             slots[i].page >= pages || slots[i].row >= msg[slots[i].page].total_rows || slots[i].width == 0)
+             goto TEXT_TEMPLATE_ERROR;
+
+         for (first = 0, c = 0; c < slots[i].page; c++)
+              first += msg[c].total_rows;
+
+         // The chars truncated are not sent.
+         span = &spans[first+slots[i].row];
+         if (slots[i].col + slots[i].width > span->size)
+             goto TEXT_TEMPLATE_ERROR;
+
+         strcpy(slot->name,slots[i].name);
+         slot->width = slots[i].width;
+         slot->first = chars;
+         chars      += slot->width;
+
+         // PPTP: DLEN, TRAN and CMD are before the data.
+         if (type == MEP_PPTP)
+         {
+             slot->pos = 5 + span->offset + slots[i].col;
+             continue;
+         }
+
+         // UoPTB: the chars must not be escaped for patch them in place.
+         slot->pos = escapedPosition(tmpl->frame,1+span->offset+slots[i].col);
+         if (memchr(&tmpl->frame->data[slot->pos],K_MEP_DLE,slot->width) != NULL)
+             goto TEXT_TEMPLATE_ERROR;
+
+         for (zeros = 0, pos = slot->pos+slot->width; pos < tmpl->frame->size; zeros++)
+              pos += (tmpl->frame->data[pos] == K_MEP_DLE) ? 2 : 1;
+
+         // The CRC is linear, so the change produced by a bit of a char is the CRC
+         // (with initial value 0) of the bit followed by zeros until the end.
+         for (b = 0; b < 8; b++)
+         {
+              crc = crc_table[0][1 << b];
+              for (pos = 0; pos < zeros; pos++)
+                   crc = (crc << 8) ^ crc_table[0][crc >> 8];
+
+              for (c = slot->width; c > 0; c--)
+              {
+                   tmpl->crc_bits[(slot->first+c-1)*8+b] = crc;
+                   crc = (crc << 8) ^ crc_table[0][crc >> 8];
+              }
+         }
+    }
+
+    tmpl->count = count;
+
+    free(spans);
+    AesysMepFreeBuffer(frame);
+
+    return tmpl;
 
-    return createSendMEPFrame(type,0xFFFE,sizeof (dev_status),trans_id,MEP_GET,(uint8_t *) dev_status);
+    TEXT_TEMPLATE_ERROR:
+
+    free(spans);
+    AesysMepFreeBuffer(frame);
+    AesysMepFreeTextTemplate(tmpl);
+
+    return NULL;
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildDiagnosticInfoMsg(uint8_t type, uint16_t trans_id)
+char AesysMepSetTextSlot(tAESYS_MEP_TEXT_TEMPLATE *tmpl, const char *name, const uint8_t *text, uint8_t size)
 {
-    tAESYS_MEP_GET_CMD diag_info[] = {
-                                       { .code = htons(MEP_CUSTOM_DIAGNOSTIC_INFO_DATA), .offset = 0, },
-                                       { .code = htons(MEP_DOORS_OPEN)                 , .offset = 0, },
-                                       { .code = htons(MEP_POWER_SAVING_STATUS)        , .offset = 0, },
-                                       { .code = htons(MEP_BATTERY_LEVEL)              , .offset = 0, },
-                                       { .code = htons(MEP_FANS_ACTIVE)                , .offset = 0, },
-                                       { .code = htons(MEP_SIREN_ACTIVE)               , .offset = 0, },
-                                       { .code = htons(MEP_HEATING_ACTIVE)             , .offset = 0, },
-                                       { .code = htons(MEP_BROKEN_FANS_NUMBER)         , .offset = 0, },
-                                       { .code = htons(MEP_BROKEN_BACKLIGHTS_NUMBER)   , .offset = 0, },
-                                       { .code = htons(MEP_INTERNAL_ERROR_CODE)        , .offset = 0, },
-                                       { .code = htons(MEP_NUM_BROKEN_LED_BOARDS)      , .offset = 0, },
-                                       { .code = htons(MEP_BROKEN_LEDS_NUMBER)         , .offset = 0, },
-                                    };
+    tAESYS_MEP_TEXT_TEMPLATE_SLOT *slot = NULL;
+    uint16_t *bits;
+    uint8_t  *dst, byte, diff, i, b;
+
+    if (tmpl == NULL || name == NULL || (text == NULL && size != 0))
+        return -1;
+
+    for (i = 0; i < tmpl->count && slot == NULL; i++)
+         if (strcmp(tmpl->slots[i].name,name) == 0)
+             slot = &tmpl->slots[i];
+
+    if (slot == NULL)
+        return 0;
+
+    if (size > slot->width)
+        return -1;
+
+    // UoPTB: the chars escaped change the size of the frame.
+    if (tmpl->frame->type != MEP_PPTP)
+        for (i = 0; i < size; i++)
+             if (text[i] == K_MEP_STX || text[i] == K_MEP_ETX || text[i] == K_MEP_DLE)
+                 return -1;
+
+    // Only the chars changed are written and added to the CRC.
+    dst  = &tmpl->frame->data[slot->pos];
+    bits = &tmpl->crc_bits[slot->first*8];
+    for (i = 0; i < slot->width; i++, bits += 8)
+    {
+         byte = (i < size) ? text[i] : ' ';
+         if ((diff = dst[i] ^ byte) == 0)
+             continue;
+
+         dst[i] = byte;
+         if (tmpl->frame->type != MEP_PPTP)
+             for (b = 0; b < 8; b++)
+                  tmpl->frame->crc ^= bits[b] & (uint16_t) -((diff >> b) & 1);
+    }
 
-    return createSendMEPFrame(type,0xFFFE,sizeof (diag_info),trans_id,MEP_GET,(uint8_t *) diag_info);
+    return 1;
 }
 //---------------------------------------------------------------------
+/**********************************************************************
+*****                      Bulk write section                     *****
+**********************************************************************/
 
-tAESYS_MEP_BUFFER * AesysMepBuildDevRestartedInfoMsg(uint8_t type, uint16_t trans_id)
+tAESYS_MEP_BULK_WRITE * AesysMepCreateBulkWrite(uint16_t code, const uint8_t *data, uint32_t size, uint16_t chunk_size, uint16_t window)
 {
-    tAESYS_MEP_GET_CMD dev_restarted = { .code = htons(MEP_DEVICE_RESTARTED), .offset = 0, };
+    tAESYS_MEP_BULK_WRITE *bulk = NULL;
+    const tAESYS_MEP_CODE_PROPERTIES *code_prop = AesysMepGetCodeProperties(code);
+
+    // Only the binary values can be written by parts.
+    if (code_prop == NULL || !(code_prop->iops & MEP_WR) || code_prop->type != MEP_BINARY ||
+        data == NULL || size == 0 || window == 0 || chunk_size > K_MEP_MAX_DATA_SIZE - K_SET_CMD_SIZE)
+        return NULL;
+
+    bulk = (tAESYS_MEP_BULK_WRITE *) calloc(1,sizeof(tAESYS_MEP_BULK_WRITE));
+    if (bulk == NULL)
+        return NULL;
+
+    bulk->data       = data;
+    bulk->size       = size;
+    bulk->code       = code;
+    bulk->window     = window;
+    bulk->chunk_size = (chunk_size == 0) ? K_MEP_MAX_DATA_SIZE - K_SET_CMD_SIZE : chunk_size;
+    bulk->chunks     = (size - 1) / bulk->chunk_size + 1;
+    bulk->state      = (uint8_t *) calloc(bulk->chunks,sizeof(uint8_t));
+    bulk->flight     = (tAESYS_MEP_BULK_FLIGHT *) malloc(window*sizeof(tAESYS_MEP_BULK_FLIGHT));
+
+    if (bulk->state == NULL || bulk->flight == NULL)
+    {
+        AesysMepFreeBulkWrite(bulk);
+        return NULL;
+    }
 
-    return createSendMEPFrame(type,0xFFFE,sizeof (dev_restarted),trans_id,MEP_GET,(uint8_t *) &dev_restarted);
+    return bulk;
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildLastPublicationInfoMsg(uint8_t type, uint16_t trans_id)
+uint8_t AesysMepBulkWriteReady(const tAESYS_MEP_BULK_WRITE *bulk)
 {
-    tAESYS_MEP_GET_CMD pub_info = { .code = htons(MEP_REMEMBER_LAST_PUBLICATION), .offset = 0, };
-
-    return createSendMEPFrame(type,0xFFFE,sizeof (pub_info),trans_id,MEP_GET,(uint8_t *) &pub_info);
+    // The chunks not done and not waiting are pending.
+    return (bulk != NULL && bulk->in_flight < bulk->window && bulk->done + bulk->in_flight < bulk->chunks);
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildTempInfoMsg(uint8_t type, uint16_t trans_id, uint16_t code)
+uint8_t AesysMepBulkWriteDone(const tAESYS_MEP_BULK_WRITE *bulk)
 {
-    uint16_t temp_codes[] = {MEP_TEMP_1,MEP_TEMP_2,MEP_TEMP_3,MEP_TEMP_4,MEP_TEMP_5,MEP_TEMP_6,MEP_TEMP_7,MEP_TEMP_8};
-    tAESYS_MEP_GET_CMD temp_info[] = {
-                                       { .code = htons(MEP_CUSTOM_TEMPERATURE_INFO_DATA), .offset = 0, },
-                                       { .code = htons(temp_codes[0])                   , .offset = 0, },
-                                       { .code = htons(temp_codes[1])                   , .offset = 0, },
-                                       { .code = htons(temp_codes[2])                   , .offset = 0, },
-                                       { .code = htons(temp_codes[3])                   , .offset = 0, },
-                                       { .code = htons(temp_codes[4])                   , .offset = 0, },
-                                       { .code = htons(temp_codes[5])                   , .offset = 0, },
-                                       { .code = htons(temp_codes[6])                   , .offset = 0, },
-                                       { .code = htons(temp_codes[7])                   , .offset = 0, },
-                                    };
+    return (bulk != NULL && bulk->done == bulk->chunks);
+}
+//---------------------------------------------------------------------
 
-    if (code != 0)
-    {
-        for (uint16_t i = 0, size = sizeof(temp_codes)/2; i < size; i++)
-        {
-             if (code == temp_codes[i])
-                 return createSendMEPFrame(type,0xFFFE,sizeof (tAESYS_MEP_GET_CMD),trans_id,MEP_GET,(uint8_t *)&temp_info[i+1]);
-        }
+tAESYS_MEP_BUFFER * bulkWriteNext(tAESYS_MEP_OUTPUT *output, tAESYS_MEP_BULK_WRITE *bulk, uint8_t type, uint16_t trans_id)
+{
+    tAESYS_MEP_BUFFER *frame;
+    tAESYS_MEP_SET_CMD cmd;
+    uint32_t chunk;
 
+    if (!AesysMepBulkWriteReady(bulk))
         return NULL;
-    }
 
-    return createSendMEPFrame(type,0xFFFE,sizeof (temp_info),trans_id,MEP_GET,(uint8_t *) temp_info);
+    // The response must identify a single chunk.
+    for (uint16_t i = 0; i < bulk->in_flight; i++)
+         if (bulk->flight[i].tran == trans_id)
+             return NULL;
+
+    // There is a pending chunk, so the search ends before the last chunk.
+    for (chunk = bulk->first; bulk->state[chunk] != K_BULK_PENDING; chunk++);
+    bulk->first = chunk;
+
+    cmd.code   = bulk->code;
+    cmd.offset = chunk * bulk->chunk_size;
+    cmd.length = (chunk == bulk->chunks - 1) ? bulk->size - cmd.offset : bulk->chunk_size;
+    cmd.data   = (uint8_t *) &bulk->data[cmd.offset];
+
+    frame = buildSetMsg(output,type,trans_id,0,&cmd,1);
+
+    // The chunk only waits for the response when the frame was built.
+    if ((output == NULL) ? (frame == NULL) : (output->result != 1))
+        return frame;
+
+    bulk->state[chunk] = K_BULK_FLIGHT;
+    bulk->flight[bulk->in_flight].tran  = trans_id;
+    bulk->flight[bulk->in_flight].chunk = chunk;
+    bulk->in_flight++;
+    bulk->first++;
+
+    return frame;
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildHumidityInfoMsg(uint8_t type, uint16_t trans_id, uint16_t code)
+tAESYS_MEP_BUFFER * AesysMepBulkWriteNext(tAESYS_MEP_BULK_WRITE *bulk, uint8_t type, uint16_t trans_id)
 {
-    uint16_t hum_codes[] = {MEP_HUMIDITY_1,MEP_HUMIDITY_2,MEP_HUMIDITY_3,MEP_HUMIDITY_4};
-    tAESYS_MEP_GET_CMD hum_info[] = {
-                                       { .code = htons(MEP_CUSTOM_HUMIDITY_INFO_DATA), .offset = 0, },
-                                       { .code = htons(hum_codes[0])                 , .offset = 0, },
-                                       { .code = htons(hum_codes[1])                 , .offset = 0, },
-                                       { .code = htons(hum_codes[2])                 , .offset = 0, },
-                                       { .code = htons(hum_codes[3])                 , .offset = 0, },
-                                    };
+    return bulkWriteNext(NULL,bulk,type,trans_id);
+}
+//---------------------------------------------------------------------
 
-    if (code != 0)
-    {
-        for (uint16_t i = 0, size = sizeof(hum_codes)/2; i < size; i++)
-        {
-             if (code == hum_codes[i])
-                 return createSendMEPFrame(type,0xFFFE,sizeof (tAESYS_MEP_GET_CMD),trans_id,MEP_GET,(uint8_t *)&hum_info[i+1]);
-        }
+char AesysMepBulkWriteNextTo(tAESYS_MEP_BULK_WRITE *bulk, uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
 
-        return NULL;
-    }
+    bulkWriteNext(&output,bulk,type,trans_id);
 
-    return createSendMEPFrame(type,0xFFFE,sizeof (hum_info),trans_id,MEP_GET,(uint8_t *) hum_info);
+    return setOutputSize(&output,b_size);
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildBrightnessInfoMsg(uint8_t type, uint16_t trans_id, uint16_t code)
+char AesysMepBulkWriteAck(tAESYS_MEP_BULK_WRITE *bulk, uint16_t trans_id, uint8_t success)
 {
-    uint16_t bright_codes[] = {MEP_BRIGHTNESS_1,MEP_BRIGHTNESS_2,MEP_BRIGHTNESS_3,MEP_BRIGHTNESS_4};
-    tAESYS_MEP_GET_CMD bright_info[] = {
-                                         { .code = htons(MEP_CUSTOM_BRIGHTNESS_INFO_DATA), .offset = 0, },
-                                         { .code = htons(bright_codes[0])                , .offset = 0, },
-                                         { .code = htons(bright_codes[1])                , .offset = 0, },
-                                         { .code = htons(bright_codes[2])                , .offset = 0, },
-                                         { .code = htons(bright_codes[3])                , .offset = 0, },
-                                       };
+    uint32_t chunk;
+    uint16_t i = 0;
 
-    if (code != 0)
-    {
-        for (uint16_t i = 0, size = sizeof(bright_codes)/2; i < size; i++)
-        {
-             if (code == bright_codes[i])
-                 return createSendMEPFrame(type,0xFFFE,sizeof (tAESYS_MEP_GET_CMD),trans_id,MEP_GET,(uint8_t *)&bright_info[i+1]);
-        }
+    if (bulk == NULL)
+        return -1;
 
-        return NULL;
+    while (i < bulk->in_flight && bulk->flight[i].tran != trans_id)
+        i++;
+
+    if (i == bulk->in_flight)
+        return 0;
+
+    // The last chunk waiting takes the place of the chunk answered.
+    chunk = bulk->flight[i].chunk;
+    bulk->flight[i] = bulk->flight[--bulk->in_flight];
+
+    if (success)
+    {
+        bulk->state[chunk] = K_BULK_DONE;
+        bulk->done++;
+    }
+    else
+    {
+        // Only the failed chunk is sent again, before the chunks never sent.
+        bulk->state[chunk] = K_BULK_PENDING;
+        if (chunk < bulk->first)
+            bulk->first = chunk;
     }
 
-    return createSendMEPFrame(type,0xFFFE,sizeof (bright_info),trans_id,MEP_GET,(uint8_t *) bright_info);
+    return 1;
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildTrafficLightInfoMsg(uint8_t type, uint16_t trans_id, uint16_t code)
+/**********************************************************************
+*****                      Bulk read section                      *****
+**********************************************************************/
+
+tAESYS_MEP_BULK_READ * AesysMepCreateBulkRead(uint16_t code, uint16_t gets, uint32_t max_size)
 {
-    uint16_t traffic_codes[] = {MEP_TRAFFIC_LIGHT_STATUS_1,MEP_TRAFFIC_LIGHT_STATUS_2,MEP_TRAFFIC_LIGHT_STATUS_3,MEP_TRAFFIC_LIGHT_STATUS_4};
-    tAESYS_MEP_GET_CMD traffic_info[] = {
-                                            { .code = htons(MEP_CUSTOM_TRAFFIC_INFO_DATA), .offset = 0, },
-                                            { .code = htons(traffic_codes[0])            , .offset = 0, },
-                                            { .code = htons(traffic_codes[1])            , .offset = 0, },
-                                            { .code = htons(traffic_codes[2])            , .offset = 0, },
-                                            { .code = htons(traffic_codes[3])            , .offset = 0, },
-                                        };
+    tAESYS_MEP_BULK_READ *bulk = NULL;
+    const tAESYS_MEP_CODE_PROPERTIES *code_prop = AesysMepGetCodeProperties(code);
 
-    if (code != 0)
-    {
-        for (uint16_t i = 0, size = sizeof(traffic_codes)/2; i < size; i++)
-        {
-             if (code == traffic_codes[i])
-                 return createSendMEPFrame(type,0xFFFE,sizeof (tAESYS_MEP_GET_CMD),trans_id,MEP_GET,(uint8_t *)&traffic_info[i+1]);
-        }
+    // The codes not supported by this library are read as they are.
+    if ((code_prop != NULL && !(code_prop->iops & MEP_RD)) || gets == 0 || max_size == 0)
+        return NULL;
 
+    bulk = (tAESYS_MEP_BULK_READ *) calloc(1,sizeof(tAESYS_MEP_BULK_READ));
+    if (bulk == NULL)
         return NULL;
-    }
 
-    return createSendMEPFrame(type,0xFFFE,sizeof (traffic_info),trans_id,MEP_GET,(uint8_t *) traffic_info);
+    bulk->code     = code;
+    bulk->gets     = gets;
+    bulk->max_size = max_size;
+
+    return bulk;
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildEnvBrightnessInfoMsg(uint8_t type, uint16_t trans_id, uint16_t code)
+uint8_t AesysMepBulkReadDone(const tAESYS_MEP_BULK_READ *bulk)
 {
-    uint16_t ebright_codes[]             = { MEP_ENVIRONMENTAL_BRIGHTNESS_1,MEP_ENVIRONMENTAL_BRIGHTNESS_2,
-                                             MEP_ENVIRONMENTAL_BRIGHTNESS_3,MEP_ENVIRONMENTAL_BRIGHTNESS_4,
-                                             MEP_ENVIRONMENTAL_BRIGHTNESS_5,MEP_ENVIRONMENTAL_BRIGHTNESS_6,
-                                             MEP_ENVIRONMENTAL_BRIGHTNESS_7,MEP_ENVIRONMENTAL_BRIGHTNESS_8 };
-    tAESYS_MEP_GET_CMD env_bright_info[] = {
-                                              { .code = htons(MEP_CUSTOM_EBRIGHTNESS_INFO_DATA), .offset = 0, },
-                                              { .code = htons(ebright_codes[0])                , .offset = 0, },
-                                              { .code = htons(ebright_codes[1])                , .offset = 0, },
-                                              { .code = htons(ebright_codes[2])                , .offset = 0, },
-                                              { .code = htons(ebright_codes[3])                , .offset = 0, },
-                                              { .code = htons(ebright_codes[4])                , .offset = 0, },
-                                              { .code = htons(ebright_codes[5])                , .offset = 0, },
-                                              { .code = htons(ebright_codes[6])                , .offset = 0, },
-                                              { .code = htons(ebright_codes[7])                , .offset = 0, },
-                                           };
+    return (bulk != NULL && bulk->done);
+}
+//---------------------------------------------------------------------
 
-    if (code != 0)
-    {
-        for (uint16_t i = 0, size = sizeof(ebright_codes)/2; i < size; i++)
-        {
-             if (code == ebright_codes[i])
-                 return createSendMEPFrame(type,0xFFFE,sizeof (tAESYS_MEP_GET_CMD),trans_id,MEP_GET,(uint8_t *)&env_bright_info[i+1]);
-        }
+tAESYS_MEP_BUFFER * bulkReadNext(tAESYS_MEP_OUTPUT *output, tAESYS_MEP_BULK_READ *bulk, uint8_t type, uint16_t trans_id)
+{
+    tAESYS_MEP_BUFFER *frame;
+    uint8_t  payload[K_MEP_MAX_DATA_SIZE], *cmd;
+    uint32_t offset, gets = 1, i;
 
+    if (bulk == NULL || bulk->done)
         return NULL;
+
+    // The size of the parts is unknown until the first one. Then all the parts
+    // requested must fit in the response and the last one can exceed max_size.
+    if (bulk->stride != 0)
+    {
+        gets = (K_MEP_MAX_DATA_SIZE - 1) / (K_DAT_CMD_SIZE + bulk->stride);
+
+        if (gets > bulk->gets)
+            gets = bulk->gets;
+        if (gets > (bulk->max_size - bulk->size) / bulk->stride + 1)
+            gets = (bulk->max_size - bulk->size) / bulk->stride + 1;
+        if (gets == 0)
+            gets = 1;
     }
 
-    return createSendMEPFrame(type,0xFFFE,sizeof (env_bright_info),trans_id,MEP_GET,(uint8_t *) env_bright_info);
-}
-//---------------------------------------------------------------------
-/**********************************************************************
-*****                 Device manipulation section                 *****
-**********************************************************************/
+    for (i = 0, offset = bulk->size; i < gets; i++, offset += bulk->stride)
+    {
+         cmd    = &payload[i*K_GET_CMD_SIZE];
+         cmd[0] = bulk->code >> 8;
+         cmd[1] = bulk->code & 0xFF;
+         cmd[2] = offset >> 24;
+         cmd[3] = (offset >> 16) & 0xFF;
+         cmd[4] = (offset >> 8) & 0xFF;
+         cmd[5] = offset & 0xFF;
+    }
 
-tAESYS_MEP_BUFFER * AesysMepBuildClearPublication(uint8_t type, uint16_t trans_id)
-{
-    uint8_t buffer[33];
-    tAESYS_MEP_SET_CMD commands[] = {
-                                      { .code = htons(MEP_CUSTOM_CLEAR_PUB), .offset = 0        , .length = 0        , .data = NULL, }, // Id cmd
-                                      { .code = htons(MEP_VIS_EXTENSIBLE)  , .offset = 0        , .length = 0        , .data = NULL, }, // Nice-start.
-                                      { .code = htons(MEP_VIS_EXTENSIBLE)  , .offset = 0        , .length = htons(1) , .data = NULL, }, // Text Msg data.
-                                      { .code = htons(MEP_VIS_EXTENSIBLE)  , .offset = htonl(1) , .length = 0        , .data = NULL, }, // Nice-end.
-                                    };
+    frame = createSendMEPFrame(output,type,0xFFFE,gets*K_GET_CMD_SIZE,trans_id,MEP_GET,payload);
 
-    buffer[24] = 0x00; // Set clear publication byte.
-    memcpy(&buffer[0] ,(uint8_t *)&commands[0],8);
-    memcpy(&buffer[8] ,(uint8_t *)&commands[1],8);
-    memcpy(&buffer[16],(uint8_t *)&commands[2],8);
-    memcpy(&buffer[25],(uint8_t *)&commands[3],8);
+    // The request only waits for the response when the frame was built.
+    if ((output == NULL) ? (frame == NULL) : (output->result != 1))
+        return frame;
 
-    return createSendMEPFrame(type,0xFFFE,sizeof(buffer),trans_id,MEP_SET,buffer);
+    bulk->tran    = trans_id;
+    bulk->waiting = 1;
+
+    return frame;
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildResetDeviceMsg(uint8_t type, uint16_t trans_id)
+tAESYS_MEP_BUFFER * AesysMepBulkReadNext(tAESYS_MEP_BULK_READ *bulk, uint8_t type, uint16_t trans_id)
 {
-    tAESYS_MEP_SET_CMD command = { .code = htons(MEP_RESET), .offset = 0x00, .length = 0x00, .data = NULL, };
-
-    return createSendMEPFrame(type,0xFFFE,8,trans_id,MEP_SET,(uint8_t *)&command);
+    return bulkReadNext(NULL,bulk,type,trans_id);
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildDelCode(uint8_t type, uint16_t trans_id, uint16_t code)
+char AesysMepBulkReadNextTo(tAESYS_MEP_BULK_READ *bulk, uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size)
 {
-    uint8_t buffer[4] = {0xFD,0xEC,0x00,0x00};
-    const tAESYS_MEP_CODE_PROPERTIES *prop = AesysMepGetCodeProperties(code);
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
 
-    if (prop == NULL || prop->iops == 1)
-        return NULL;
-
-    code = htons(code);
-    memcpy(&buffer[2],&code,2);
+    bulkReadNext(&output,bulk,type,trans_id);
 
-    return createSendMEPFrame(type,0xFFFE,sizeof(buffer),trans_id,MEP_DEL,buffer);
+    return setOutputSize(&output,b_size);
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildClockMsg(uint8_t type, uint16_t trans_id, uint8_t *clock)
+char AesysMepBulkReadFeed(tAESYS_MEP_BULK_READ *bulk, uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type)
 {
-    uint8_t buffer[14];
-    uint8_t days_per_month[]   = {31,29,31,30,31,30,31,31,30,31,30,31};
-    tAESYS_MEP_SET_CMD command = { .code = htons(MEP_CLOCK), .offset = 0, .length = htons(6), .data = clock, };
-
-    // Validating CLOCK values. Remember format is ymdhms
-    if (clock == NULL || clock[1] == 0 || clock[1] > 12 || clock[2] == 0 ||
-        clock[2] > days_per_month[clock[1]-1] || clock[3] > 24 || clock[4] > 59 || clock[5] > 59)
-        return NULL;
+    char ret;
+    uint8_t *data;
+    uint32_t capacity;
+    tAESYS_MEP_DAT_CMD dat;
+    tAESYS_MEP_DAT_ITERATOR iterator;
 
-    memcpy(&buffer[0],(uint8_t *)&command,8);
-    memcpy(&buffer[8],clock,6);
+    if (bulk == NULL)
+    {
+        errno = EINVAL;
+        return -1;
+    }
 
-    return createSendMEPFrame(type,0xFFFE,sizeof(buffer),trans_id,MEP_SET,buffer);
-}
-//---------------------------------------------------------------------
+    if (AesysMepInitDatIterator(mep_frame,mep_frame_size,mep_frame_type,&iterator) == -1)
+        return -1;
 
-tAESYS_MEP_BUFFER * AesysMepBuildBrightnessMsg(uint8_t type, uint16_t trans_id, uint16_t values[])
-{
-    uint16_t offset = 8;
-    uint8_t buffer[44] = {0};
-    tAESYS_MEP_SET_CMD commands[] = {
-                                       { .code = htons(MEP_CUSTOM_SET_BRIGHTNESS), .offset = 0, .length = 0       , .data = NULL, },
-                                       { .code = htons(MEP_BRIGHTNESS_1)         , .offset = 0, .length = htons(1), .data = NULL, },
-                                       { .code = htons(MEP_BRIGHTNESS_2)         , .offset = 0, .length = htons(1), .data = NULL, },
-                                       { .code = htons(MEP_BRIGHTNESS_3)         , .offset = 0, .length = htons(1), .data = NULL, },
-                                       { .code = htons(MEP_BRIGHTNESS_4)         , .offset = 0, .length = htons(1), .data = NULL, },
-                                    };
+    if (!bulk->waiting || iterator.tran != bulk->tran)
+        return 0;
 
-    if (values == NULL)
-        return NULL;
+    bulk->waiting = 0;
 
-    memcpy(&buffer[0],(uint8_t *)&commands[0],8);
-    for (uint16_t i = 0, j = 1; i < 4; i++, j++)
+    while ((ret = AesysMepReadNextDatIterator(&iterator,&dat,NULL)) == 1)
     {
-         if (values[i] <= 255)
-         {
-             memcpy(&buffer[offset],(uint8_t *)&commands[j],8);
-             buffer[offset+8] = values[i];
-             offset += 9;
-         }
-    }
+        // Only the part that continues the value. The parts after a gap or
+        // after the last part are ignored.
+        if (dat.code != bulk->code || bulk->done || dat.offset != bulk->size)
+            continue;
 
-    if (offset == 8)
-        return NULL;
+        if ((dat.flags & K_MEP_DAT_ERROR_MASK) || ((dat.flags & K_MEP_DAT_MORE_DATA) && dat.length == 0))
+        {
+            errno = EIO;
+            return -1;
+        }
 
-    return createSendMEPFrame(type,0xFFFE,offset,trans_id,MEP_SET,buffer);
-}
-//---------------------------------------------------------------------
+        if (dat.length > bulk->max_size - bulk->size)
+        {
+            errno = EFBIG;
+            return -1;
+        }
 
-tAESYS_MEP_BUFFER * AesysMepBuildLastPublicationStatusMsg(uint8_t type, uint16_t trans_id, uint8_t status)
-{
-    uint8_t buffer[9];
-    tAESYS_MEP_SET_CMD command = { .code = htons(MEP_REMEMBER_LAST_PUBLICATION), .offset = 0, .length = htons(1), .data = NULL, };
+        // The buffer grows twice the size for few reallocations.
+        if (bulk->size + dat.length > bulk->capacity)
+        {
+            capacity = (bulk->capacity > bulk->max_size / 2) ? bulk->max_size : bulk->capacity * 2;
+            if (capacity < bulk->size + dat.length)
+                capacity = bulk->size + dat.length;
+
+            if ((data = (uint8_t *) realloc(bulk->data,capacity)) == NULL)
+            {
+                errno = ENOMEM;
+                return -1;
+            }
+
+            bulk->data     = data;
+            bulk->capacity = capacity;
+        }
 
-    memcpy(&buffer[0],(uint8_t *)&command,8);
-    buffer[8] = (status) ? 1 : 0;
+        memcpy(&bulk->data[bulk->size],dat.data,dat.length);
+        bulk->size += dat.length;
+
+        // The next parts are requested with the size of the last part.
+        if (dat.flags & K_MEP_DAT_MORE_DATA)
+            bulk->stride = dat.length;
+        else
+            bulk->done = 1;
+    }
+
+    if (ret == -1)
+    {
+        errno = ENOEXEC;
+        return -1;
+    }
 
-    return createSendMEPFrame(type,0xFFFE,sizeof(buffer),trans_id,MEP_SET,buffer);
+    return 1;
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildDeviceIdMsg(uint8_t type, uint16_t trans_id, uint16_t size, const char *strId)
+#ifdef AESYS_MEP_GZIP
+/**********************************************************************
+*****                         Gzip section                        *****
+**********************************************************************/
+
+char inflatePayload(tAESYS_MEP_PPTP_VIEW *view, uint8_t *dst, uint16_t d_size)
 {
-    uint8_t buffer[32] = {0};
-    size = (size > 16) ? 16 : size;
-    tAESYS_MEP_SET_CMD commands[] = {
-                                       { .code = htons(MEP_CUSTOM_SET_DEVID), .offset = 0, .length = 0          , .data = NULL, },
-                                       { .code = htons(MEP_DEVICE_ID)       , .offset = 0, .length = htons(size), .data = NULL, }
-                                    };
+    int ret;
+    z_stream stream;
 
-    if (strId == NULL)
-        return NULL;
+    memset(&stream,0,sizeof(stream));
+    if (inflateInit2(&stream,K_GUNZIP_WBITS) != Z_OK)
+        return -1;
 
-    memcpy(&buffer[0],(uint8_t *)&commands[0],8);
-    memcpy(&buffer[8],(uint8_t *)&commands[1],8);
-    memcpy(&buffer[16],strId,size);
+    stream.next_in   = view->payload;
+    stream.avail_in  = view->dlen;
+    stream.next_out  = dst;
+    stream.avail_out = d_size;
 
-    return createSendMEPFrame(type,0xFFFE,sizeof(buffer),trans_id,MEP_SET,buffer);
-}
-//---------------------------------------------------------------------
+    ret = inflate(&stream,Z_FINISH);
+    inflateEnd(&stream);
 
-tAESYS_MEP_BUFFER * AesysMepBuildDeviceDescMsg(uint8_t type, uint16_t trans_id, uint16_t size, const char *desc)
-{
-    uint8_t buffer[80] = {0};
-    size = (size > 64) ? 64 : size;
-    tAESYS_MEP_SET_CMD commands[] = {
-                                       { .code = htons(MEP_CUSTOM_SET_DEVDESC), .offset = 0, .length = 0          , .data = NULL, },
-                                       { .code = htons(MEP_DEVICE_DESCRIPTION), .offset = 0, .length = htons(size), .data = NULL, }
-                                    };
+    if (ret == Z_BUF_ERROR && stream.avail_out == 0)
+        return 0;
 
-    if (desc == NULL)
-        return NULL;
+    // The payload must be only one complete gzip member.
+    if (ret != Z_STREAM_END || stream.avail_in != 0)
+        return -1;
 
-    memcpy(&buffer[0],(uint8_t *)&commands[0],8);
-    memcpy(&buffer[8],(uint8_t *)&commands[1],8);
-    memcpy(&buffer[16],desc,size);
+    view->cmd    &= ~K_MEP_GZIP_CMD;
+    view->dlen    = (uint16_t) stream.total_out;
+    view->payload = dst;
 
-    return createSendMEPFrame(type,0xFFFE,sizeof(buffer),trans_id,MEP_SET,buffer);
+    return 1;
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildTrafficLightStatusMsg(uint8_t type, uint16_t trans_id, uint16_t code, uint16_t value)
+tAESYS_MEP_BUFFER * buildGzipMsg(tAESYS_MEP_OUTPUT *output, uint8_t type, uint8_t *mep_frame, uint16_t mep_frame_size)
 {
-    uint8_t byte;
-    uint8_t buffer[18];
-    tAESYS_MEP_SET_CMD commands[] = {
-                                       { .code = htons(MEP_CUSTOM_SET_TRAFFIC), .offset = 0, .length = 0       , .data = NULL },
-                                       { .code = htons(code)                  , .offset = 0, .length = htons(2), .data = NULL }
-                                    };
+    int ret;
+    z_stream stream;
+    uint16_t addr = 0;
+    tAESYS_MEP_PPTP_VIEW view;
+    tAESYS_MEP_BUFFER *frame = NULL;
+    uint8_t *decoded = NULL, *wrapped = NULL, packed[K_MEP_MAX_DATA_SIZE];
+
+    if (mep_frame == NULL || type > 2 || mep_frame_size > K_MEP_MAX_FRAME_SIZE)
+        return NULL;
 
-    if (code >= 0x814C && code <= 0x814F)
+    if (type == MEP_PPTP)
     {
-        memcpy(&buffer[0],(uint8_t *)&commands[0],8);
-        memcpy(&buffer[8],(uint8_t *)&commands[1],8);
+        if (!AesysMepViewPPTPFrame(mep_frame,mep_frame_size,&view))
+            return NULL;
+    }
+    else
+    {
+        // The UoPTB frames without STX/ETX are decoded as a complete frame.
+        if (type == MEP_UPTBNTX)
+        {
+            wrapped = (uint8_t *) malloc(mep_frame_size+2);
+            if (wrapped == NULL)
+                return NULL;
+
+            wrapped[0] = K_MEP_STX;
+            memcpy(&wrapped[1],mep_frame,mep_frame_size);
+            wrapped[mep_frame_size+1] = K_MEP_ETX;
+            mep_frame       = wrapped;
+            mep_frame_size += 2;
+        }
 
-        byte = (value >> 8) & 0x07;
-        if (byte != 1 && byte != 2 && byte != 4)
+        decoded = AesysMepDecodeUPTBFrame(mep_frame,mep_frame_size);
+        free(wrapped);
+        if (decoded == NULL)
             return NULL;
 
-        buffer[16] = byte;
+        addr         = ((tAESYS_MEP_UPTB_FRAME *) decoded)->addr;
+        view.dlen    = ((tAESYS_MEP_UPTB_FRAME *) decoded)->pptp.dlen;
+        view.tran    = ((tAESYS_MEP_UPTB_FRAME *) decoded)->pptp.tran;
+        view.cmd     = ((tAESYS_MEP_UPTB_FRAME *) decoded)->pptp.cmd;
+        view.payload = &((tAESYS_MEP_UPTB_FRAME *) decoded)->pptp.payload;
+    }
 
-        byte = value & 0x07;
-        if (byte != 1 && byte != 2 && byte != 4)
-            return NULL;
+    if (view.cmd & K_MEP_GZIP_CMD)
+        goto GZIP_END;
 
-        buffer[17] = byte;
+    memset(&stream,0,sizeof(stream));
+    if (deflateInit2(&stream,Z_BEST_COMPRESSION,Z_DEFLATED,K_GZIP_WBITS,8,Z_DEFAULT_STRATEGY) != Z_OK)
+        goto GZIP_END;
 
-        return createSendMEPFrame(type,0xFFFE,sizeof(buffer),trans_id,MEP_SET,buffer);
-    }
+    // The output is limited to the payload size, so if it's not enough the
+    // compressed payload isn't smaller and the frame is sent without compress.
+    stream.next_in   = view.payload;
+    stream.avail_in  = view.dlen;
+    stream.next_out  = packed;
+    stream.avail_out = view.dlen;
 
-    return NULL;
+    ret = deflate(&stream,Z_FINISH);
+    deflateEnd(&stream);
+
+    if (ret == Z_STREAM_END && stream.total_out < view.dlen)
+        frame = createSendMEPFrame(output,type,addr,(uint16_t) stream.total_out,view.tran,view.cmd | K_MEP_GZIP_CMD,packed);
+    else
+        frame = createSendMEPFrame(output,type,addr,view.dlen,view.tran,view.cmd,view.payload);
+
+GZIP_END:
+    free(decoded);
+
+    return frame;
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildPictogramMsg(uint8_t type, uint16_t trans_id, uint8_t flashing_lamps, uint16_t picto_code)
+tAESYS_MEP_BUFFER * AesysMepBuildGzipMsg(uint8_t type, uint8_t *mep_frame, uint16_t mep_frame_size)
 {
-    uint8_t buffer[42];
-    tAESYS_MEP_VIS_EXT_PAGE page  = { .duration = 0x05, .params = 0x00, .type = 0x01, .size = htons(0x02), .page_def = 0x00, };
-    tAESYS_MEP_SET_CMD commands[] = {
-                                      { .code = htons(MEP_CUSTOM_SET_PICTO), .offset = 0        , .length = 0        , .data = NULL, }, // Id cmd
-                                      { .code = htons(MEP_VIS_EXTENSIBLE)  , .offset = 0        , .length = 0        , .data = NULL, }, // Nice-start.
-                                      { .code = htons(MEP_VIS_EXTENSIBLE)  , .offset = 0        , .length = htons(10), .data = NULL, }, // Text Msg data.
-                                      { .code = htons(MEP_VIS_EXTENSIBLE)  , .offset = htonl(10), .length = 0        , .data = NULL, }, // Nice-end.
-                                    };
+    return buildGzipMsg(NULL,type,mep_frame,mep_frame_size);
+}
+//---------------------------------------------------------------------
 
-    page.params = (flashing_lamps) ? 1 : 0;
-    picto_code  = htons(picto_code);
+char AesysMepBuildGzipMsgTo(uint8_t type, uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t *buffer, uint16_t *b_size)
+{
+    tAESYS_MEP_OUTPUT output = OUTPUT_INIT(buffer,b_size);
 
-    // Add the ID cmd, the GET command and VisExt Page
-    memcpy(&buffer[0] ,(uint8_t *)&commands[0],8);
-    memcpy(&buffer[8] ,(uint8_t *)&commands[1],8);
-    memcpy(&buffer[16],(uint8_t *)&commands[2],8);
-    memcpy(&buffer[24],"\x01\x00\x01"         ,3);
-    memcpy(&buffer[27],(uint8_t *)&page       ,5);
-    memcpy(&buffer[32],&picto_code            ,2);
-    memcpy(&buffer[34],(uint8_t *)&commands[3],8);
+    buildGzipMsg(&output,type,mep_frame,mep_frame_size);
 
-    return createSendMEPFrame(type,0xFFFE,sizeof(buffer),trans_id,MEP_SET,buffer);
+    return setOutputSize(&output,b_size);
 }
 //---------------------------------------------------------------------
 
-tAESYS_MEP_BUFFER * AesysMepBuildTextMsg(uint8_t type, uint16_t trans_id, uint8_t size, const tAESYS_MEP_MSG_DATA *msg, const tAESYS_MEP_PANEL_DATA *panel)
+char AesysMepInflateResponseTo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, uint8_t *buffer, uint16_t *b_size)
 {
-    int psize;
-    uint16_t offset = 27;
-    char vis_h[3] = {0x01,0x00,0x01};
-    tAESYS_MEP_VIS_EXT_PAGE *pages = NULL;
-    uint8_t buffer[K_MEP_MAX_DATA_SIZE] = {0};
-    tAESYS_MEP_SET_CMD commands[]   = {
-                                         { .code = htons(MEP_CUSTOM_SET_TEXT), .offset = 0, .length = 0, .data = NULL, }, // Id cmd
-                                         { .code = htons(MEP_VIS_EXTENSIBLE) , .offset = 0, .length = 0, .data = NULL, }, // Nice-start.
-                                         { .code = htons(MEP_VIS_EXTENSIBLE) , .offset = 0, .length = 0, .data = NULL, }, // Text Msg data.
-                                         { .code = htons(MEP_VIS_EXTENSIBLE) , .offset = 0, .length = 0, .data = NULL, }, // Nice-end.
-                                      };
-
-    // Check for invalid parameters
-    if (msg == NULL || panel == NULL || size == 0 || panel->font_size[0] == 0 || panel->font_size[1] == 0)
-        return NULL;
+    uint8_t *decoded = NULL, *isize;
+    uint16_t size;
+    tAESYS_MEP_PPTP_VIEW view;
 
-    // Assign memory for every page
-    pages = (tAESYS_MEP_VIS_EXT_PAGE *) calloc(size,sizeof(tAESYS_MEP_VIS_EXT_PAGE));
-    if (pages == NULL)
-        return NULL;
+    if (mep_frame == NULL || mep_frame_type > 1 || b_size == NULL)
+    {
+        errno = EINVAL;
+        return -1;
+    }
 
-    vis_h[2] = size;
-    memcpy(&buffer[0] ,(uint8_t *)&commands[0],8);
-    memcpy(&buffer[8] ,(uint8_t *)&commands[1],8);
-    memcpy(&buffer[24],vis_h,3);
+    // The UoPTB frame is decoded in the same buffer.
+    if (mep_frame_type)
+    {
+        if ((decoded = AesysMepDecodeUPTBFrameInPlace(mep_frame,mep_frame_size)) == NULL)
+        {
+            errno = ENOEXEC;
+            return -1;
+        }
 
-    for (uint8_t p = 0; p < size; p++)
+        view.dlen    = ((tAESYS_MEP_UPTB_FRAME *) decoded)->pptp.dlen;
+        view.tran    = ((tAESYS_MEP_UPTB_FRAME *) decoded)->pptp.tran;
+        view.cmd     = ((tAESYS_MEP_UPTB_FRAME *) decoded)->pptp.cmd;
+        view.payload = &((tAESYS_MEP_UPTB_FRAME *) decoded)->pptp.payload;
+    }
+    else if (!AesysMepViewPPTPFrame(mep_frame,mep_frame_size,&view))
     {
-         offset+= 5;
-         if (msg[p].rows == NULL || msg[p].total_rows == 0)
-             break;
+        errno = ENOEXEC;
+        return -1;
+    }
 
-         pages[p].duration = (msg[p].duration == 0) ? 1 : msg[p].duration;
-         pages[p].params   = msg[p].parameters & 3;
-         pages[p].type     = 0;
+    if (view.cmd != MEP_DAT && view.cmd != MEP_DAT_GZ)
+    {
+        errno = EPERM;
+        return -1;
+    }
 
-         if ((psize = addTextProperties(buffer,&offset,&msg[p],panel)) == -1)
-             break;
+    // The gzip trailer ends with the size of the inflated data (little endian).
+    size = view.dlen;
+    if (view.cmd == MEP_DAT_GZ)
+    {
+        if (view.dlen < K_GZIP_MIN_SIZE)
+        {
+            errno = ENOEXEC;
+            return -1;
+        }
 
-         pages[p].size     = htons(psize);
-         memcpy(&buffer[offset-psize-5],(uint8_t *)&pages[p],5);
+        isize = &view.payload[view.dlen-4];
+        if (isize[2] || isize[3] || (size = isize[0] | isize[1] << 8) > K_MEP_MAX_DATA_SIZE)
+        {
+            errno = ENOEXEC;
+            return -1;
+        }
     }
 
-    free(pages);
-
-    if (psize == -1 || offset+8 > K_MEP_MAX_DATA_SIZE)
-        return NULL;
+    if (buffer == NULL || *b_size < size+5)
+    {
+        *b_size = size+5;
+        return 0;
+    }
 
-    commands[2].length = htons(offset-24);
-    commands[3].offset = htonl(offset-24);
+    if (view.cmd == MEP_DAT)
+        memmove(&buffer[5],view.payload,size);
+    else if (inflatePayload(&view,&buffer[5],size) != 1 || view.dlen != size)
+    {
+        errno = ENOEXEC;
+        return -1;
+    }
 
-    // Add the VISEXT for MSG and nice-end
-    memcpy(&buffer[16],(uint8_t *)&commands[2],8);
-    memcpy(&buffer[offset] ,(uint8_t *)&commands[3],8);
-    offset += 8;
+    buffer[0] = size >> 8;
+    buffer[1] = size & 0xFF;
+    buffer[2] = view.tran >> 8;
+    buffer[3] = view.tran & 0xFF;
+    buffer[4] = MEP_DAT;
+    *b_size   = size+5;
 
-    return createSendMEPFrame(type,0xFFFE,offset,trans_id,MEP_SET,buffer);
+    return 1;
 }
 //---------------------------------------------------------------------
+#endif
+
 /**********************************************************************
 *****                    Free resources section                   *****
 **********************************************************************/
@@ -1292,21 +4243,78 @@ void AesysMepFreeBuffer(tAESYS_MEP_BUFFER *buffer)
 }
 //---------------------------------------------------------------------
 
+void AesysMepFreeFrameTemplate(tAESYS_MEP_FRAME_TEMPLATE *tmpl)
+{
+    if (tmpl != NULL)
+    {
+        if (tmpl->data != NULL)
+            free(tmpl->data);
+
+        free(tmpl);
+    }
+}
+//---------------------------------------------------------------------
+
+void AesysMepFreeTextTemplate(tAESYS_MEP_TEXT_TEMPLATE *tmpl)
+{
+    if (tmpl != NULL)
+    {
+        AesysMepFreeFrameTemplate(tmpl->frame);
+
+        if (tmpl->slots != NULL)
+            free(tmpl->slots);
+
+        if (tmpl->crc_bits != NULL)
+            free(tmpl->crc_bits);
+
+        free(tmpl);
+    }
+}
+//---------------------------------------------------------------------
+
+void AesysMepFreeBulkWrite(tAESYS_MEP_BULK_WRITE *bulk)
+{
+    if (bulk != NULL)
+    {
+        if (bulk->state != NULL)
+            free(bulk->state);
+
+        if (bulk->flight != NULL)
+            free(bulk->flight);
+
+        free(bulk);
+    }
+}
+//---------------------------------------------------------------------
+
+void AesysMepFreeBulkRead(tAESYS_MEP_BULK_READ *bulk)
+{
+    if (bulk != NULL)
+    {
+        if (bulk->data != NULL)
+            free(bulk->data);
+
+        free(bulk);
+    }
+}
+//---------------------------------------------------------------------
+
 void AesysMepFreeResponse(tAESYS_MEP_RESPONSE *response)
 {
     tAESYS_MEP_RESPONSE_DATA *current = NULL;
 
-    if (response != NULL)
+    if (response != NULL && !response->arena)
     {
         while (response->data != NULL)
         {
-            free(response->data->resp_data);
+            if (response->data->resp_data != response->data->value)
+                free(response->data->resp_data);
             current = response->data;
             response->data = response->data->next;
             free(current);
         }
-
-        free(response);
     }
+
+    free(response);
 }
 //---------------------------------------------------------------------
@@ -84,12 +84,22 @@
 #define K_MEP_MAX_FRAME_SIZE     0x4000
 #define K_MEP_MAX_DATA_SIZE      0x1FF7
 #define K_MEP_TEXT_COLORS_SIZE   0x0005
+#define K_MEP_SLOT_NAME_SIZE     0x0010
 #define K_MEP_PANEL_ELEMENTS     0x0002
 #define K_MEP_MIN_SIZE_UPTB      0x000D
 #define K_MEP_MIN_SIZE_PPTB      0x0007
 #define K_MEP_STX                0x0002
 #define K_MEP_ETX                0x0003
 #define K_MEP_DLE                0x0010
+#define K_MEP_MAX_DAT_ENTRIES    0x038D
+#define K_MEP_DAT_ERROR_MASK     0x0F
+#define K_MEP_DAT_MORE_DATA      0x20
+
+// The bit of the gzip commands isn't documented by this library. Must be
+// the value of the device firmware, e.g. -DK_MEP_GZIP_CMD=0x..
+#if defined(AESYS_MEP_GZIP) && !defined(K_MEP_GZIP_CMD)
+    #error "AESYS_MEP_GZIP requires K_MEP_GZIP_CMD with the gzip bit of the device firmware."
+#endif
 
 //---------------------------------------------------------------------
 /**********************************************************************
@@ -107,97 +117,125 @@ enum AESYS_MEP_FRAME_TYPES
 };
 
 /// Represents the available MEP commands.
-/// At this moment the gzip versions are not supported.
+/// The gzip versions are the same commands with the K_MEP_GZIP_CMD bit set. They
+/// are only supported when the library is compiled with AESYS_MEP_GZIP (zlib)
+/// and K_MEP_GZIP_CMD.
 enum AESYS_MEP_COMMANDS {
     MEP_SET = 0x80,
     MEP_GET       ,
     MEP_DEL       ,
     MEP_DAT       ,
+#ifdef AESYS_MEP_GZIP
+    MEP_SET_GZ = MEP_SET | K_MEP_GZIP_CMD,
+    MEP_GET_GZ = MEP_GET | K_MEP_GZIP_CMD,
+    MEP_DEL_GZ = MEP_DEL | K_MEP_GZIP_CMD,
+    MEP_DAT_GZ = MEP_DAT | K_MEP_GZIP_CMD,
+#endif
 };
 
+/// The MEP codes supported by this library with their properties as
+/// X(name, code, nbne, iops, type). The name is the code without the MEP_
+/// prefix. The AESYS_MEP_CODES enumeration, the properties returned by
+/// AesysMepGetCodeProperties and the names returned by AesysMepGetCodeName
+/// are generated from this list, so a new code is only added here.
+#define AESYS_MEP_CODES_LIST(X) \
+    X(STATUS                    , 0x0000, 0, MEP_RD, MEP_VOID   ) \
+    X(HARDWARE_MODEL            , 0x0001, 0, MEP_RD, MEP_STRING ) \
+    X(FIRMWARE_MODEL            , 0x0002, 0, MEP_RD, MEP_STRING ) \
+    X(FIRMWARE_VERSION          , 0x0003, 0, MEP_RD, MEP_STRING ) \
+    X(FIRMWARE_RELEASE          , 0x0004, 0, MEP_RD, MEP_STRING ) \
+    X(FIRMWARE_DEVICE_TYPE      , 0x0005, 0, MEP_RW, MEP_UINT8  ) \
+    X(DEVICE_ID                 , 0x000A, 0, MEP_RW, MEP_STRING ) \
+    X(DEVICE_DESCRIPTION        , 0x000B, 1, MEP_RW, MEP_STRING ) \
+    X(RESET                     , 0x0066, 0, MEP_WR, MEP_VOID   ) \
+    X(VIS_EXTENSIBLE            , 0x03EE, 0, MEP_RW, MEP_BINARY ) \
+    X(TEMP_1                    , 0x2711, 0, MEP_RD, MEP_INT8   ) \
+    X(TEMP_2                    , 0x2712, 0, MEP_RD, MEP_INT8   ) \
+    X(TEMP_3                    , 0x2713, 0, MEP_RD, MEP_INT8   ) \
+    X(TEMP_4                    , 0x2714, 0, MEP_RD, MEP_INT8   ) \
+    X(TEMP_5                    , 0x2715, 0, MEP_RD, MEP_INT8   ) \
+    X(TEMP_6                    , 0x2716, 0, MEP_RD, MEP_INT8   ) \
+    X(TEMP_7                    , 0x2717, 0, MEP_RD, MEP_INT8   ) \
+    X(TEMP_8                    , 0x2718, 0, MEP_RD, MEP_INT8   ) \
+    X(HUMIDITY_1                , 0x2775, 0, MEP_RD, MEP_UINT8  ) \
+    X(HUMIDITY_2                , 0x2776, 0, MEP_RD, MEP_UINT8  ) \
+    X(HUMIDITY_3                , 0x2777, 0, MEP_RD, MEP_UINT8  ) \
+    X(HUMIDITY_4                , 0x2778, 0, MEP_RD, MEP_UINT8  ) \
+    X(ENVIRONMENTAL_BRIGHTNESS_1, 0x27D9, 0, MEP_RD, MEP_UINT8  ) \
+    X(ENVIRONMENTAL_BRIGHTNESS_2, 0x27DA, 0, MEP_RD, MEP_UINT8  ) \
+    X(ENVIRONMENTAL_BRIGHTNESS_3, 0x27DB, 0, MEP_RD, MEP_UINT8  ) \
+    X(ENVIRONMENTAL_BRIGHTNESS_4, 0x27DC, 0, MEP_RD, MEP_UINT8  ) \
+    X(ENVIRONMENTAL_BRIGHTNESS_5, 0x27DD, 0, MEP_RD, MEP_UINT8  ) \
+    X(ENVIRONMENTAL_BRIGHTNESS_6, 0x27DE, 0, MEP_RD, MEP_UINT8  ) \
+    X(ENVIRONMENTAL_BRIGHTNESS_7, 0x27DF, 0, MEP_RD, MEP_UINT8  ) \
+    X(ENVIRONMENTAL_BRIGHTNESS_8, 0x27E0, 0, MEP_RD, MEP_UINT8  ) \
+    X(LED_BRIGHTNESS_OUTPUT     , 0x4E84, 0, MEP_RD, MEP_UINT16 ) \
+    X(LED_OUTPUT_PERCENTAGE     , 0x4E85, 0, MEP_RD, MEP_UINT8  ) \
+    X(DEVICE_RESTARTED          , 0x5209, 0, MEP_RD, MEP_BOOL   ) \
+    X(DOORS_OPEN                , 0x520A, 0, MEP_RD, MEP_BOOL   ) \
+    X(INTERNAL_ERROR_CODE       , 0x5217, 0, MEP_RD, MEP_UINT16 ) \
+    X(POWER_SAVING_STATUS       , 0x521C, 0, MEP_RD, MEP_UINT8  ) \
+    X(BATTERY_LEVEL             , 0x521D, 0, MEP_RW, MEP_UINT8  ) \
+    X(FANS_ACTIVE               , 0x55F1, 0, MEP_RD, MEP_BOOL   ) \
+    X(HEATING_ACTIVE            , 0x55F2, 0, MEP_RD, MEP_BOOL   ) \
+    X(SIREN_ACTIVE              , 0x55F3, 0, MEP_RD, MEP_BOOL   ) \
+    X(BROKEN_FANS_NUMBER        , 0x59D9, 0, MEP_RD, MEP_UINT8  ) \
+    X(BROKEN_LEDS_NUMBER        , 0x59DB, 0, MEP_RD, MEP_UINT32 ) \
+    X(BROKEN_BACKLIGHTS_NUMBER  , 0x59DD, 0, MEP_RD, MEP_UINT8  ) \
+    X(NUM_BROKEN_LED_BOARDS     , 0x59DF, 0, MEP_RD, MEP_UINT16 ) \
+    X(CLOCK                     , 0x7531, 0, MEP_RW, MEP_BINARY ) \
+    X(COLORS_CALIBRATION        , 0x7562, 0, MEP_RW, MEP_BINARY ) \
+    X(REMEMBER_LAST_PUBLICATION , 0x811A, 0, MEP_RW, MEP_BOOL   ) \
+    X(BRIGHTNESS_1              , 0x7D01, 0, MEP_RW, MEP_UINT8  ) \
+    X(BRIGHTNESS_2              , 0x7D02, 0, MEP_RW, MEP_UINT8  ) \
+    X(BRIGHTNESS_3              , 0x7D03, 0, MEP_RW, MEP_UINT8  ) \
+    X(BRIGHTNESS_4              , 0x7D04, 0, MEP_RW, MEP_UINT8  ) \
+    X(TRAFFIC_LIGHT_STATUS_1    , 0x814C, 0, MEP_RW, MEP_BINARY ) \
+    X(TRAFFIC_LIGHT_STATUS_2    , 0x814D, 0, MEP_RW, MEP_BINARY ) \
+    X(TRAFFIC_LIGHT_STATUS_3    , 0x814E, 0, MEP_RW, MEP_BINARY ) \
+    X(TRAFFIC_LIGHT_STATUS_4    , 0x814F, 0, MEP_RW, MEP_BINARY )
+
+/// Custom response codes that group a set of MEP codes as X(name, code). The
+/// name is the code without the MEP_CUSTOM_ prefix. The codes must be consecutive.
+#define AESYS_MEP_CUSTOM_CODES_LIST(X) \
+    X(SET_TEXT             , 0xFDE8) /* Returned in a response when detect is part of message created with AesysMepBuildTextMsg. */ \
+    X(SET_PICTO            , 0xFDE9) /* Returned in a response when detect is part of message created with AesysMepBuildPictogramMsg. */ \
+    X(SET_DEVID            , 0xFDEA) /* Returned in a response when detect is part of message created with AesysMepBuildDeviceIdMsg. */ \
+    X(SET_TRAFFIC          , 0xFDEB) /* Returned in a response when detect is part of message created with AesysMepBuildTrafficMsg. */ \
+    X(SET_DEVDESC          , 0xFDEC) /* Returned in a response when detect is part of message created with AesysMepBuildDeviceDescMsg. */ \
+    X(SET_BRIGHTNESS       , 0xFDED) /* Returned in a response when detect is part of message created with AesysMepBuildBrightnessMsg and set all codes. */ \
+    X(CLEAR_PUB            , 0xFDEE) /* Returned in a response when detect is part of message created with AesysMepBuildClearPublication. */ \
+    X(DELETE_CODE          , 0xFDEF) /* Returned in a response when detect is part of message created with AesysMepBuildDeleteCode. */ \
+    X(STATUS_INFO_DATA     , 0xFDF0) /* Returned in a response when detect is part of message created with AesysMepBuildDeviceInfoMsg. */ \
+    X(DEVICE_INFO_DATA     , 0xFDF1) /* Returned in a response when detect is part of message created with AesysMepBuildDevStatusInfoMsg. */ \
+    X(TRAFFIC_INFO_DATA    , 0xFDF2) /* Returned in a response when detect is part of message created with AesysMepBuildTrafficLightInfoMsg and retrieve all codes. */ \
+    X(HUMIDITY_INFO_DATA   , 0xFDF3) /* Returned in a response when detect is part of message created with AesysMepBuildHumidityInfoMsg and retrieve all codes. */ \
+    X(BRIGHTNESS_INFO_DATA , 0xFDF4) /* Returned in a response when detect is part of message created with AesysMepBuildBrightnessInfoMsg and retrieve all codes. */ \
+    X(DIAGNOSTIC_INFO_DATA , 0xFDF5) /* Returned in a response when detect is part of message created with AesysMepBuildDiagnosticInfoMsg. */ \
+    X(TEMPERATURE_INFO_DATA, 0xFDF6) /* Returned in a response when detect is part of message created with AesysMepBuildTempInfoMsg and retrieve all codes. */ \
+    X(EBRIGHTNESS_INFO_DATA, 0xFDF7) /* Returned in a response when detect is part of message created with AesysMepBuildEnvBrightnessInfoMsg and retrieve all codes. */ \
+    X(SET_PUBLICATION      , 0xFDF8) /* Returned in a response when detect is part of message created with AesysMepBuildPublicationMsg. */
+
+#define AESYS_MEP_CODE_ENUM(name,code,nbne,iops,type) MEP_##name = code,
+#define AESYS_MEP_CUSTOM_CODE_ENUM(name,code) MEP_CUSTOM_##name = code,
+
 /// Represents the codes supported by a MEP command.
 /// This enumeration only has the MEP codes supported by this library.
 enum AESYS_MEP_CODES
 {
-    MEP_STATUS                     = 0x0000,
-    MEP_HARDWARE_MODEL             = 0x0001,
-    MEP_FIRMWARE_MODEL             = 0x0002,
-    MEP_FIRMWARE_VERSION           = 0x0003,
-    MEP_FIRMWARE_RELEASE           = 0x0004,
-    MEP_FIRMWARE_DEVICE_TYPE       = 0x0005,
-    MEP_DEVICE_ID                  = 0x000A,
-    MEP_DEVICE_DESCRIPTION         = 0x000B,
-    MEP_RESET                      = 0x0066,
-    MEP_VIS_EXTENSIBLE             = 0x03EE,
-    MEP_TEMP_1                     = 0x2711,
-    MEP_TEMP_2                     = 0x2712,
-    MEP_TEMP_3                     = 0x2713,
-    MEP_TEMP_4                     = 0x2714,
-    MEP_TEMP_5                     = 0x2715,
-    MEP_TEMP_6                     = 0x2716,
-    MEP_TEMP_7                     = 0x2717,
-    MEP_TEMP_8                     = 0x2718,
-    MEP_HUMIDITY_1                 = 0x2775,
-    MEP_HUMIDITY_2                 = 0x2776,
-    MEP_HUMIDITY_3                 = 0x2777,
-    MEP_HUMIDITY_4                 = 0x2778,
-    MEP_ENVIRONMENTAL_BRIGHTNESS_1 = 0x27D9,
-    MEP_ENVIRONMENTAL_BRIGHTNESS_2 = 0x27DA,
-    MEP_ENVIRONMENTAL_BRIGHTNESS_3 = 0x27DB,
-    MEP_ENVIRONMENTAL_BRIGHTNESS_4 = 0x27DC,
-    MEP_ENVIRONMENTAL_BRIGHTNESS_5 = 0x27DD,
-    MEP_ENVIRONMENTAL_BRIGHTNESS_6 = 0x27DE,
-    MEP_ENVIRONMENTAL_BRIGHTNESS_7 = 0x27DF,
-    MEP_ENVIRONMENTAL_BRIGHTNESS_8 = 0x27E0,
-    MEP_LED_BRIGHTNESS_OUTPUT      = 0x4E84,
-    MEP_LED_OUTPUT_PERCENTAGE      = 0x4E85,
-    MEP_DEVICE_RESTARTED           = 0x5209,
-    MEP_DOORS_OPEN                 = 0x520A,
-    MEP_INTERNAL_ERROR_CODE        = 0x5217,
-    MEP_POWER_SAVING_STATUS        = 0x521C,
-    MEP_BATTERY_LEVEL              = 0x521D,
-    MEP_FANS_ACTIVE                = 0x55F1,
-    MEP_HEATING_ACTIVE             = 0x55F2,
-    MEP_SIREN_ACTIVE               = 0x55F3,
-    MEP_BROKEN_FANS_NUMBER         = 0x59D9,
-    MEP_BROKEN_LEDS_NUMBER         = 0x59DB,
-    MEP_BROKEN_BACKLIGHTS_NUMBER   = 0x59DD,
-    MEP_NUM_BROKEN_LED_BOARDS      = 0x59DF,
-    MEP_CLOCK                      = 0x7531,
-    MEP_COLORS_CALIBRATION         = 0x7562,
-    MEP_REMEMBER_LAST_PUBLICATION  = 0x811A,
-    MEP_BRIGHTNESS_1               = 0x7D01,
-    MEP_BRIGHTNESS_2               = 0x7D02,
-    MEP_BRIGHTNESS_3               = 0x7D03,
-    MEP_BRIGHTNESS_4               = 0x7D04,
-    MEP_TRAFFIC_LIGHT_STATUS_1     = 0x814C,
-    MEP_TRAFFIC_LIGHT_STATUS_2     = 0x814D,
-    MEP_TRAFFIC_LIGHT_STATUS_3     = 0x814E,
-    MEP_TRAFFIC_LIGHT_STATUS_4     = 0x814F,
+    AESYS_MEP_CODES_LIST(AESYS_MEP_CODE_ENUM)
 };
 
 /// Represents custom response codes that group a set of MEP codes.
 /// This codes are used when parse a response with function AesysMepParseResponse.
 enum AESYS_MEP_CUSTOM_CODES
 {
-    MEP_CUSTOM_SET_TEXT              = 0xFDE8, ///< Returned in a response when detect is part of message created with AesysMepBuildTextMsg.
-    MEP_CUSTOM_SET_PICTO             = 0xFDE9, ///< Returned in a response when detect is part of message created with AesysMepBuildPictogramMsg.
-    MEP_CUSTOM_SET_DEVID             = 0xFDEA, ///< Returned in a response when detect is part of message created with AesysMepBuildDeviceIdMsg.
-    MEP_CUSTOM_SET_TRAFFIC           = 0xFDEB, ///< Returned in a response when detect is part of message created with AesysMepBuildTrafficMsg.
-    MEP_CUSTOM_SET_DEVDESC           = 0xFDEC, ///< Returned in a response when detect is part of message created with AesysMepBuildDeviceDescMsg.
-    MEP_CUSTOM_SET_BRIGHTNESS        = 0xFDED, ///< Returned in a response when detect is part of message created with AesysMepBuildBrightnessMsg and set all codes.
-    MEP_CUSTOM_CLEAR_PUB             = 0xFDEE, ///< Returned in a response when detect is part of message created with AesysMepBuildClearPublication.
-    MEP_CUSTOM_DELETE_CODE           = 0xFDEF, ///< Returned in a response when detect is part of message created with AesysMepBuildDeleteCode.
-    MEP_CUSTOM_STATUS_INFO_DATA      = 0xFDF0, ///< Returned in a response when detect is part of message created with AesysMepBuildDeviceInfoMsg.
-    MEP_CUSTOM_DEVICE_INFO_DATA      = 0xFDF1, ///< Returned in a response when detect is part of message created with AesysMepBuildDevStatusInfoMsg.
-    MEP_CUSTOM_TRAFFIC_INFO_DATA     = 0xFDF2, ///< Returned in a response when detect is part of message created with AesysMepBuildTrafficLightInfoMsg and retrieve all codes.
-    MEP_CUSTOM_HUMIDITY_INFO_DATA    = 0xFDF3, ///< Returned in a response when detect is part of message created with AesysMepBuildHumidityInfoMsg and retrieve all codes.
-    MEP_CUSTOM_BRIGHTNESS_INFO_DATA  = 0xFDF4, ///< Returned in a response when detect is part of message created with AesysMepBuildBrightnessInfoMsg and retrieve all codes.
-    MEP_CUSTOM_DIAGNOSTIC_INFO_DATA  = 0xFDF5, ///< Returned in a response when detect is part of message created with AesysMepBuildDiagnosticInfoMsg.
-    MEP_CUSTOM_TEMPERATURE_INFO_DATA = 0xFDF6, ///< Returned in a response when detect is part of message created with AesysMepBuildTempInfoMsg and retrieve all codes.
-    MEP_CUSTOM_EBRIGHTNESS_INFO_DATA = 0xFDF7, ///< Returned in a response when detect is part of message created with AesysMepBuildEnvBrightnessInfoMsg and retrieve all codes.
+    AESYS_MEP_CUSTOM_CODES_LIST(AESYS_MEP_CUSTOM_CODE_ENUM)
 };
 
+#undef AESYS_MEP_CODE_ENUM
+#undef AESYS_MEP_CUSTOM_CODE_ENUM
+
 /// Represents the available types in MEP protocol.
 enum AESYS_MEP_TYPES
 {
@@ -221,6 +259,41 @@ enum AESYS_MEP_CODE_IO
     MEP_WR,
     MEP_RW,
 };
+
+/// Represents the types of the pages of a publication. The values are the VisExtensible page types.
+enum AESYS_MEP_PAGE_TYPES
+{
+    MEP_PAGE_TEXT  = 0x00,   ///< Page by buffer with a text.
+    MEP_PAGE_PICTO,          ///< Page by code with a pictogram.
+};
+
+/// Bits of the "valid" member in tAESYS_MEP_DIAGNOSTIC_INFO.
+enum AESYS_MEP_DIAGNOSTIC_FIELDS
+{
+    MEP_DIAG_DOORS_OPEN         = 0x0001,
+    MEP_DIAG_POWER_SAVING       = 0x0002,
+    MEP_DIAG_BATTERY_LEVEL      = 0x0004,
+    MEP_DIAG_FANS_ACTIVE        = 0x0008,
+    MEP_DIAG_SIREN_ACTIVE       = 0x0010,
+    MEP_DIAG_HEATING_ACTIVE     = 0x0020,
+    MEP_DIAG_BROKEN_FANS        = 0x0040,
+    MEP_DIAG_BROKEN_BACKLIGHTS  = 0x0080,
+    MEP_DIAG_INTERNAL_ERROR     = 0x0100,
+    MEP_DIAG_BROKEN_LED_BOARDS  = 0x0200,
+    MEP_DIAG_BROKEN_LEDS        = 0x0400,
+};
+
+/// Bits of the "valid" member in tAESYS_MEP_DEVICE_INFO.
+enum AESYS_MEP_DEVICE_INFO_FIELDS
+{
+    MEP_DEVINFO_HARDWARE_MODEL   = 0x0001,
+    MEP_DEVINFO_FIRMWARE_MODEL   = 0x0002,
+    MEP_DEVINFO_FIRMWARE_VERSION = 0x0004,
+    MEP_DEVINFO_FIRMWARE_RELEASE = 0x0008,
+    MEP_DEVINFO_DEVICE_TYPE      = 0x0010,
+    MEP_DEVINFO_DEVICE_ID        = 0x0020,
+    MEP_DEVINFO_DESCRIPTION      = 0x0040,
+};
 //---------------------------------------------------------------------
 /**********************************************************************
 *****                      Structures Section                     *****
@@ -305,6 +378,163 @@ typedef struct
     uint8_t *data;     ///< Buffer that have a MEP msg to send.
 }tAESYS_MEP_BUFFER;
 
+/**
+ *
+ * @struct tAESYS_MEP_FRAME_TEMPLATE
+ * @brief  A MEP frame encoded once to be sent many times with distinct transaction
+ *         id. Created with AesysMepCreateFrameTemplate and must be freeing using the
+ *         AesysMepFreeFrameTemplate function. Don't modify the members.
+ */
+typedef struct
+{
+    uint8_t  type;          ///< The type of frame. See AESYS_MEP_FRAME_TYPES enum.
+    uint8_t  head_size;     ///< UoPTB: size of head.
+    uint16_t start;         ///< UoPTB: position of the CMD escaped in data.
+    uint16_t size;          ///< PPTP: frame size. UoPTB: end of the DATA escaped in data.
+    uint16_t crc;           ///< UoPTB: CRC of the frame with transaction id 0.
+    uint16_t crc_tran[16];  ///< UoPTB: change of the CRC produced by each bit of the transaction id.
+    uint8_t  head[9];       ///< UoPTB: STX, ADDR and DLEN escaped.
+    uint8_t *data;          ///< The frame. UoPTB: room for the head and the transaction id, CMD and DATA escaped and room for CRC and ETX.
+}tAESYS_MEP_FRAME_TEMPLATE;
+
+/**
+ *
+ * @struct tAESYS_MEP_BULK_FLIGHT
+ * @brief  A chunk of a bulk write sent and waiting for the response.
+ */
+typedef struct
+{
+    uint16_t tran;            ///< The transaction id used to send the chunk.
+    uint32_t chunk;           ///< The chunk.
+}tAESYS_MEP_BULK_FLIGHT;
+
+/**
+ *
+ * @struct tAESYS_MEP_BULK_WRITE
+ * @brief  Write a MEP_BINARY value bigger than a frame. The value is split in chunks
+ *         sent as SET commands addressed by offset, and up to "window" chunks can wait
+ *         for the response at the same time. Created with AesysMepCreateBulkWrite and
+ *         must be freeing using the AesysMepFreeBulkWrite function. Don't modify the members.
+ */
+typedef struct
+{
+    const uint8_t *data;      ///< The value to write. It's not copied.
+    uint32_t size;            ///< The size of the value.
+    uint32_t chunks;          ///< Number of chunks.
+    uint32_t first;           ///< No chunk before it is pending to send.
+    uint32_t done;            ///< Chunks written by the device.
+    uint16_t code;            ///< The code to write.
+    uint16_t chunk_size;      ///< Bytes of the value in each chunk.
+    uint16_t window;          ///< Max chunks waiting for the response.
+    uint16_t in_flight;       ///< Chunks waiting for the response.
+    uint8_t *state;           ///< State of each chunk: pending, waiting for the response or done.
+    tAESYS_MEP_BULK_FLIGHT *flight; ///< The chunks waiting for the response.
+}tAESYS_MEP_BULK_WRITE;
+
+/**
+ *
+ * @struct tAESYS_MEP_BULK_READ
+ * @brief  Read a value returned by parts, i.e. the DAT commands with the "more data"
+ *         flag (K_MEP_DAT_MORE_DATA). The parts are joined in a single buffer. Created
+ *         with AesysMepCreateBulkRead and must be freeing using the AesysMepFreeBulkRead
+ *         function. Don't modify the members.
+ */
+typedef struct
+{
+    uint16_t code;            ///< The code to read.
+    uint16_t tran;            ///< The transaction id of the request waiting for the response.
+    uint16_t gets;            ///< Max GET commands in each request.
+    uint8_t  waiting;         ///< 1 if a request is waiting for the response.
+    uint8_t  done;            ///< 1 when the last part was read.
+    uint32_t stride;          ///< Size of the parts returned by the device. 0 until the first part.
+    uint32_t size;            ///< Size of the value read.
+    uint32_t capacity;        ///< Size of data.
+    uint32_t max_size;        ///< Max size of the value.
+    uint8_t *data;            ///< The value read.
+}tAESYS_MEP_BULK_READ;
+
+/**
+ *
+ * @struct tAESYS_MEP_DAT_ITERATOR
+ * @brief  Iterates the DAT commands of a response on demand. The data stay in the
+ *         received frame, so the iterator is valid while the frame buffer is valid.
+ *         Must be initialized with AesysMepInitDatIterator.
+ */
+typedef struct
+{
+    uint16_t tran;     ///< Represents the transaction id that response have.
+    uint16_t dlen;     ///< The size of the payload.
+    uint16_t offset;   ///< The position of the next DAT command in the payload.
+    uint8_t *payload;  ///< The DAT payload inside the frame buffer.
+}tAESYS_MEP_DAT_ITERATOR;
+
+/**
+ *
+ * @struct tAESYS_MEP_INDEX_ENTRY
+ * @brief  Represents a code in a response indexed by AesysMepIndexResponse. The data
+ *         of the code are in the payload of tAESYS_MEP_RESPONSE_INDEX at "offset".
+ */
+typedef struct
+{
+    uint16_t code;     ///< The MEP code. For more information see AESYS_MEP_CODES enumeration.
+    uint8_t  flag;     ///< The status flag. See tAESYS_MEP_RESPONSE_DATA.
+    uint8_t  type;     ///< The MEP type of the data. See AESYS_MEP_TYPES enumeration.
+    uint16_t offset;   ///< The position of the data in the payload.
+    uint16_t length;   ///< The size of the data.
+}tAESYS_MEP_INDEX_ENTRY;
+
+/**
+ *
+ * @struct tAESYS_MEP_RESPONSE_INDEX
+ * @brief  A response indexed by code without copy the data. The entries are sorted
+ *         by code and the data stay in the received frame, so the index is valid
+ *         while the frame buffer is valid. Use the AesysMepGetXXX functions for
+ *         read the values.
+ */
+typedef struct
+{
+    uint16_t tran;     ///< Represents the transaction id that response have.
+    uint16_t type;     ///< The first code in the response. See tAESYS_MEP_RESPONSE.
+    uint16_t count;    ///< The number of entries.
+    uint8_t *payload;  ///< The DAT payload inside the frame buffer.
+    tAESYS_MEP_INDEX_ENTRY entries[K_MEP_MAX_DAT_ENTRIES]; ///< The codes in the response sorted by code.
+}tAESYS_MEP_RESPONSE_INDEX;
+
+/**
+ *
+ * @struct tAESYS_MEP_PPTP_VIEW
+ * @brief  Represents a PPTP frame inside a received buffer without copy it. The
+ *         header fields are in Host Order Byte and payload points to the received
+ *         buffer, so it's valid while the buffer is valid.
+ */
+typedef struct
+{
+    uint16_t dlen;     ///< The size of the payload
+    uint16_t tran;     ///< The id transaction.
+    uint8_t  cmd;      ///< The MEP command.
+    uint8_t *payload;  ///< MEP payload inside the received buffer.
+}tAESYS_MEP_PPTP_VIEW;
+
+/**
+ *
+ * @struct tAESYS_MEP_UPTB_DEFRAMER
+ * @brief  Keeps the state of a UoPTB stream between calls to AesysMepReadNextUPTBFrame.
+ *         The bytes received are unescaped and added to the CRC only once, when
+ *         they arrive. When a frame is complete the "frame" member have the same
+ *         format returned by AesysMepDecodeUPTBFrame and can be casted to
+ *         (tAESYS_MEP_UPTB_FRAME *). Must be initialized with AesysMepInitUPTBDeframer.
+ */
+typedef struct
+{
+    uint8_t  state;     ///< 0 searching STX, 1 receiving a frame.
+    uint8_t  escape;    ///< 1 if the last byte received was a DLE.
+    uint16_t crc;       ///< CRC of the decoded bytes.
+    uint16_t size;      ///< Decoded bytes of the current frame. UoPTB header, data and CRC.
+    uint16_t dlen;      ///< Data size of the current frame. Valid when the header is complete.
+    uint32_t errors;    ///< Number of frames discarded: bad escape, length, command or CRC.
+    uint8_t  frame[K_MEP_MAX_DATA_SIZE+11]; ///< Decoded frame. CRC,ADDR,DLEN,TRANS,CMD,DATA.
+}tAESYS_MEP_UPTB_DEFRAMER;
+
 /**
  *
  * @struct tAESYS_MEP_RESPONSE_DATA
@@ -332,6 +562,7 @@ typedef struct resp_data
     uint16_t size;          ///< The size for the resp_data member.
     void *resp_data;        ///< The data in a response as a void pointer. Cast to correct type using "type" member.
     struct resp_data *next; ///< The next data structure in a response. NULL if there isn't more data.
+    uint8_t  value[8];      ///< Storage used by resp_data when the size is <= 8 bytes. Don't use directly.
 }tAESYS_MEP_RESPONSE_DATA;
 
 /**
@@ -358,8 +589,81 @@ typedef struct
     uint16_t tran;                   ///< Represents the transaction id that response have.
     uint16_t type;                   ///< Indicates if the response is a set of codes. See enum AESYS_MEP_CUSTOM_CODES
     tAESYS_MEP_RESPONSE_DATA *data;  ///< The MEP response data. Cast to correct type acording to "type" member.
+    uint8_t  arena;                  ///< 1 if the response was allocated in a single block by AesysMepParseResponseArena.
 }tAESYS_MEP_RESPONSE;
 
+/**
+ *
+ * @struct tAESYS_MEP_STRING_VIEW
+ * @brief  A string inside a received frame. It's not null terminated.
+ */
+typedef struct
+{
+    const char *data;  ///< The string inside the frame buffer.
+    uint16_t length;   ///< The size of the string.
+}tAESYS_MEP_STRING_VIEW;
+
+/**
+ *
+ * @struct tAESYS_MEP_DIAGNOSTIC_INFO
+ * @brief  The response of AesysMepBuildDiagnosticInfoMsg decoded by AesysMepDecodeDiagnosticInfo.
+ *         A field is only valid if his bit is set in "valid". See AESYS_MEP_DIAGNOSTIC_FIELDS.
+ */
+typedef struct
+{
+    uint16_t tran;              ///< Represents the transaction id that response have.
+    uint16_t valid;             ///< The fields received without error.
+    uint8_t  doors_open;        ///< MEP_DOORS_OPEN
+    uint8_t  power_saving;      ///< MEP_POWER_SAVING_STATUS
+    uint8_t  battery_level;     ///< MEP_BATTERY_LEVEL
+    uint8_t  fans_active;       ///< MEP_FANS_ACTIVE
+    uint8_t  siren_active;      ///< MEP_SIREN_ACTIVE
+    uint8_t  heating_active;    ///< MEP_HEATING_ACTIVE
+    uint8_t  broken_fans;       ///< MEP_BROKEN_FANS_NUMBER
+    uint8_t  broken_backlights; ///< MEP_BROKEN_BACKLIGHTS_NUMBER
+    uint16_t internal_error;    ///< MEP_INTERNAL_ERROR_CODE
+    uint16_t broken_led_boards; ///< MEP_NUM_BROKEN_LED_BOARDS
+    uint32_t broken_leds;       ///< MEP_BROKEN_LEDS_NUMBER
+}tAESYS_MEP_DIAGNOSTIC_INFO;
+
+/**
+ *
+ * @struct tAESYS_MEP_DEVICE_INFO
+ * @brief  The response of AesysMepBuildDeviceInfoMsg decoded by AesysMepDecodeDeviceInfo.
+ *         A field is only valid if his bit is set in "valid". See AESYS_MEP_DEVICE_INFO_FIELDS.
+ *         The strings points to the frame, so are valid while the frame buffer is valid.
+ */
+typedef struct
+{
+    uint16_t tran;                           ///< Represents the transaction id that response have.
+    uint16_t valid;                          ///< The fields received without error.
+    uint8_t  device_type;                    ///< MEP_FIRMWARE_DEVICE_TYPE
+    tAESYS_MEP_STRING_VIEW hardware_model;   ///< MEP_HARDWARE_MODEL
+    tAESYS_MEP_STRING_VIEW firmware_model;   ///< MEP_FIRMWARE_MODEL
+    tAESYS_MEP_STRING_VIEW firmware_version; ///< MEP_FIRMWARE_VERSION
+    tAESYS_MEP_STRING_VIEW firmware_release; ///< MEP_FIRMWARE_RELEASE
+    tAESYS_MEP_STRING_VIEW device_id;        ///< MEP_DEVICE_ID
+    tAESYS_MEP_STRING_VIEW description;      ///< MEP_DEVICE_DESCRIPTION
+}tAESYS_MEP_DEVICE_INFO;
+
+/**
+ *
+ * @struct tAESYS_MEP_SENSORS_INFO
+ * @brief  The response of AesysMepBuildTempInfoMsg, AesysMepBuildHumidityInfoMsg,
+ *         AesysMepBuildBrightnessInfoMsg, AesysMepBuildEnvBrightnessInfoMsg or
+ *         AesysMepBuildTrafficLightInfoMsg decoded by the AesysMepDecodeXXXInfo functions.
+ *         The bit "i" in "valid" is set when values[i] was received without error. The
+ *         index is the number of the code minus one, i.e. MEP_TEMP_3 is values[2].
+ *         The temperatures are int8_t values and the traffic light status have the
+ *         same format used in AesysMepBuildTrafficLightStatusMsg.
+ */
+typedef struct
+{
+    uint16_t tran;      ///< Represents the transaction id that response have.
+    uint16_t valid;     ///< The values received without error.
+    int16_t values[8];  ///< The values of the codes.
+}tAESYS_MEP_SENSORS_INFO;
+
 #pragma pack(1)
 
 /**
@@ -502,6 +806,67 @@ typedef struct
     tAESYS_MEP_MSG_ROW *rows; ///< Pointer to struct that have all rows information.
 }tAESYS_MEP_MSG_DATA;
 
+/**
+ *
+ * @struct tAESYS_MEP_PUB_PAGE
+ * @brief  A page of a publication built with AesysMepBuildPublicationMsg. The page
+ *         can be a text or a pictogram. The duration and params are used for both
+ *         types, so the duration and parameters members of msg are ignored.
+ */
+typedef struct
+{
+    uint8_t  type;            ///< The type of the page. See AESYS_MEP_PAGE_TYPES enum.
+    uint8_t  duration;        ///< Time to show the page. 0 is changed to 1. The time unit is set in params.
+    uint8_t  params;          ///< Bit 0 is for enable flashing lamps. Bit 1 to change the unit time for the page duration. 0 = seconds, 1 = tenths (1/10) of seconds
+    uint16_t picto_code;      ///< MEP_PAGE_PICTO: the code of the pictogram.
+    const tAESYS_MEP_MSG_DATA *msg; ///< MEP_PAGE_TEXT: the text of the page. See AesysMepBuildTextMsg.
+}tAESYS_MEP_PUB_PAGE;
+
+/**
+ *
+ * @struct tAESYS_MEP_TEXT_SLOT
+ * @brief  A variable part of a text publication template. The slot reserves a fixed
+ *         number of chars in a row, so the alignment and the sizes of the publication
+ *         don't change when the slot is updated. The chars must be sent in the row, i.e.
+ *         not removed when the row is truncated.
+ */
+typedef struct
+{
+    const char *name;         ///< Name used to update the slot. Max K_MEP_SLOT_NAME_SIZE-1 chars.
+    uint8_t  page;            ///< The page of the slot. i.e. the position in the msg array.
+    uint16_t row;             ///< The row of the slot in the page.
+    uint16_t col;             ///< The position of the first char of the slot in the row.
+    uint8_t  width;           ///< The chars reserved by the slot.
+}tAESYS_MEP_TEXT_SLOT;
+
+/**
+ *
+ * @struct tAESYS_MEP_TEXT_TEMPLATE_SLOT
+ * @brief  A slot compiled into a tAESYS_MEP_TEXT_TEMPLATE. Don't modify the members.
+ */
+typedef struct
+{
+    char     name[K_MEP_SLOT_NAME_SIZE]; ///< Name of the slot.
+    uint16_t pos;             ///< Position of the first char in the data of the frame template.
+    uint16_t first;           ///< UoPTB: index of the first char in crc_bits of the template.
+    uint8_t  width;           ///< The chars reserved by the slot.
+}tAESYS_MEP_TEXT_TEMPLATE_SLOT;
+
+/**
+ *
+ * @struct tAESYS_MEP_TEXT_TEMPLATE
+ * @brief  A text publication encoded once with variable slots. Created with
+ *         AesysMepCreateTextTemplate and must be freeing using the
+ *         AesysMepFreeTextTemplate function. Don't modify the members.
+ */
+typedef struct
+{
+    tAESYS_MEP_FRAME_TEMPLATE *frame;     ///< The frame. Use AesysMepPatchFrameTemplate to send it.
+    tAESYS_MEP_TEXT_TEMPLATE_SLOT *slots; ///< The slots.
+    uint16_t *crc_bits;       ///< UoPTB: change of the CRC produced by each bit of each char of the slots. 8 per char.
+    uint8_t   count;          ///< Number of slots.
+}tAESYS_MEP_TEXT_TEMPLATE;
+
 //---------------------------------------------------------------------
 /**********************************************************************
 *****                  Decode functions section                   *****
@@ -522,6 +887,16 @@ extern "C"{
  */
 AESYS_MEP_API const tAESYS_MEP_CODE_PROPERTIES * AESYS_MEP_CONV AesysMepGetCodeProperties(uint16_t code);
 
+/** @brief Get the name of a MEP code or a custom code.
+ *
+ * The name is the enumeration name without the MEP_ or MEP_CUSTOM_ prefix,
+ * i.e. "TEMP_1" for MEP_TEMP_1 or "SET_TEXT" for MEP_CUSTOM_SET_TEXT.
+ *
+ * @param  code The MEP code or custom code to get the name.
+ * @return Const string with the name of the code or NULL if the code is not supported by this library.
+ */
+AESYS_MEP_API const char * AESYS_MEP_CONV AesysMepGetCodeName(uint16_t code);
+
 /** @brief Decode and validate UPTB frame and fill the corresponding
  *         structure.
  *
@@ -551,6 +926,91 @@ AESYS_MEP_API const tAESYS_MEP_CODE_PROPERTIES * AESYS_MEP_CONV AesysMepGetCodeP
  */
 AESYS_MEP_API uint8_t * AESYS_MEP_CONV AesysMepDecodeUPTBFrame(const uint8_t *frame, uint16_t frame_size);
 
+/** @brief Validate a PPTP frame and get its header fields and payload without copy it.
+ *
+ * Same validations as AesysMepCncopyPPTPFrame: minimum size, data size and cmd. The
+ * frame is not modified. If the frame is valid then view have the header fields in
+ * Host Order Byte and a pointer to the payload inside the frame param.
+ *
+ * @param  frame      The frame to validate.
+ * @param  frame_size The size of the frame.
+ * @param  view       Pointer to a valid struct for save the frame.
+ * @return 0 if the frame is not valid. 1 if the frame is valid.
+ */
+AESYS_MEP_API uint8_t AESYS_MEP_CONV AesysMepViewPPTPFrame(uint8_t *frame, uint16_t frame_size, tAESYS_MEP_PPTP_VIEW *view);
+
+/** @brief Read the PPTP frames from a stream that can have several frames or an incomplete frame.
+ *
+ * Data, offset and view must be valid pointers. If not are valid then return -1.
+ * d_size is the size of data and if offset > d_size then return -1.
+ *
+ * The frame that starts at offset is delimited using its "dlen" header field. When the
+ * frame is complete then return 1, view have the header fields and points to the payload
+ * inside data (nothing is copied) and offset is the position of the next frame. Call the
+ * function again for read the next frames. If the frame is incomplete then return 0 and
+ * offset is not changed, the bytes from offset must be kept and completed with the next
+ * received data. If the header have an invalid command or data size then return -1,
+ * because the stream cannot be delimited.
+ *
+ * @param  data    The bytes received.
+ * @param  d_size  Is the size of the data param.
+ * @param  offset  Used for save the position in the data. Must be start in 0.
+ * @param  view    Pointer to a valid struct for save the frame.
+ * @return -1 if an error occurred. 0 if need more data. 1 if a frame is available.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepReadNextPPTPFrame(uint8_t *data, uint16_t d_size, uint16_t *offset, tAESYS_MEP_PPTP_VIEW *view);
+
+/** @brief Initialize a UoPTB deframer before use it with AesysMepReadNextUPTBFrame.
+ *
+ * If deframer is NULL then do nothing.
+ *
+ * @param  deframer Pointer to the deframer to initialize.
+ * @return void
+ */
+AESYS_MEP_API void AESYS_MEP_CONV AesysMepInitUPTBDeframer(tAESYS_MEP_UPTB_DEFRAMER *deframer);
+
+/** @brief Read the UoPTB frames from a stream received in chunks of any size.
+ *
+ * Deframer, data and offset must be valid pointers. If not are valid then return -1.
+ * d_size is the size of data and if offset > d_size then return -1.
+ *
+ * The data are processed from offset. When a complete frame with a valid CRC is found
+ * the function returns 1, the frame is in deframer->frame (see tAESYS_MEP_UPTB_DEFRAMER)
+ * and offset is the position after the ETX byte. Call the function again with the same
+ * data and offset for read the next frames. When all data was processed without complete
+ * a frame then return 0 and the partial frame is kept in the deframer for the next chunk.
+ *
+ * The bytes before STX are ignored. A frame with bad escape bytes, bad length, bad
+ * command or bad CRC is discarded, the "errors" member is incremented and the reading
+ * continues in the next STX. The frame returned is valid until the next call.
+ *
+ * This function not support UoPTBNTX frames.
+ *
+ * @param  deframer Pointer to the deframer initialized with AesysMepInitUPTBDeframer.
+ * @param  data     The bytes received.
+ * @param  d_size   Is the size of the data param.
+ * @param  offset   Used for save the position in the data. Must be start in 0 for each chunk.
+ * @return -1 if an error occurred. 0 if need more data. 1 if a frame is available.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepReadNextUPTBFrame(tAESYS_MEP_UPTB_DEFRAMER *deframer, const uint8_t *data, uint16_t d_size, uint16_t *offset);
+
+/** @brief Decode and validate UPTB frame in the same buffer, without allocate memory.
+ *
+ * Same as AesysMepDecodeUPTBFrame but the decoded frame is written inside the
+ * frame param. The unescaped frame is always shorter than the escaped frame, so
+ * the decoded frame fits in the received buffer. The frame content is modified
+ * even if an error occurred.
+ *
+ * The return value points inside frame (at an even address) and can be casted
+ * as pointer to (tAESYS_MEP_UPTB_FRAME *) structure. It's valid while frame is
+ * valid and must NOT be released.
+ *
+ * @param  frame      The frame to decode and validate. Is overwritten with the decoded frame.
+ * @param  frame_size The size of the frame.
+ * @return NULL on error or pointer to the decoded frame inside frame param.
+ */
+AESYS_MEP_API uint8_t * AESYS_MEP_CONV AesysMepDecodeUPTBFrameInPlace(uint8_t *frame, uint16_t frame_size);
+
 /** @brief Validate and creates a new copy of PPTP frame and fill the
  *         corresponding structure.
  *
@@ -709,7 +1169,7 @@ AESYS_MEP_API char AESYS_MEP_CONV AesysMepReadNextDatCMD(uint8_t *payload, uint1
  * and decoded internally by this function using one of the following functions:
  *
  *      AesysMepDecodeUPTBFrame for UoPTB frames or
- *      AesysMepCncopyPPTPFrame for  PPTP frames.
+ *      AesysMepViewPPTPFrame   for  PPTP frames (the frame is not copied).
  *
  * ATENTION:
  *
@@ -741,6 +1201,9 @@ AESYS_MEP_API char AESYS_MEP_CONV AesysMepReadNextDatCMD(uint8_t *payload, uint1
  *      SIZES:     0          1           2         3 | > 4         4
  *      TYPES: MEP_VOID | MEP_UINT8 | MEP_UINT16 | MEP_BINARY | MEP_UINT32 |
  *
+ * When the library is compiled with AESYS_MEP_GZIP the MEP_DAT_GZ responses are
+ * inflated and parsed as a MEP_DAT response.
+ *
  * @param  mep_frame      A complete MEP frame that have a response. Must be as it is received by RX buffer.
  * @param  mep_frame_size The size of the mep_frame.
  * @param  mep_frame_type The type of mep_frame. 0: PPTP or 1: UPTB. See AESYS_MEP_FRAME_TYPES enum.
@@ -748,6 +1211,219 @@ AESYS_MEP_API char AESYS_MEP_CONV AesysMepReadNextDatCMD(uint8_t *payload, uint1
  */
 AESYS_MEP_API tAESYS_MEP_RESPONSE * AESYS_MEP_CONV AesysMepParseResponse(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type);
 
+/** @brief Same as AesysMepParseResponse but the whole response is allocated in a single block.
+ *
+ * The tAESYS_MEP_RESPONSE structure, all tAESYS_MEP_RESPONSE_DATA nodes and their data
+ * use one memory allocation sized from the frame payload, so parse a response costs one
+ * malloc and free it costs one free. The response is used in the same way and must be
+ * freeing by the developer using the function AesysMepFreeResponse.
+ *
+ * @param  mep_frame      A complete MEP frame that have a response. Must be as it is received by RX buffer.
+ * @param  mep_frame_size The size of the mep_frame.
+ * @param  mep_frame_type The type of mep_frame. 0: PPTP or 1: UPTB. See AESYS_MEP_FRAME_TYPES enum.
+ * @return NULL on error an errno is set with specified error or pointer to a tAESYS_MEP_RESPONSE structure.
+ */
+AESYS_MEP_API tAESYS_MEP_RESPONSE * AESYS_MEP_CONV AesysMepParseResponseArena(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type);
+
+/** @brief Validate a response and prepare an iterator over its DAT commands.
+ *
+ * Validates the frame as AesysMepParseResponse but nothing is parsed, copied or allocated.
+ * The DAT commands are read on demand with AesysMepReadNextDatIterator, so the reading can
+ * stop as soon as the needed code is found. The UoPTB frames are decoded in place with
+ * AesysMepDecodeUPTBFrameInPlace so the frame content is modified.
+ *
+ * The MEP_DAT_GZ responses can't be read in place and fail with ENOTSUP. The caller
+ * must write them first as a MEP_DAT frame with AesysMepInflateResponseTo.
+ *
+ * @param  mep_frame      A complete MEP frame that have a response. Must be as it is received by RX buffer.
+ * @param  mep_frame_size The size of the mep_frame.
+ * @param  mep_frame_type The type of mep_frame. 0: PPTP or 1: UPTB. See AESYS_MEP_FRAME_TYPES enum.
+ * @param  iterator       Pointer to a valid struct for save the iterator.
+ * @return -1 on error an errno is set with specified error (same as AesysMepParseResponse). 1 if ok.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepInitDatIterator(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_DAT_ITERATOR *iterator);
+
+/** @brief Read the next DAT command of a response.
+ *
+ * Same as AesysMepReadNextDatCMD, cmd->data points to the frame. The codes not
+ * supported by the device are returned too (flags 1). If type is not NULL then
+ * have the MEP type of the data, assigned as in tAESYS_MEP_RESPONSE_DATA.
+ *
+ * @param  iterator The iterator initialized with AesysMepInitDatIterator.
+ * @param  cmd      Pointer to a valid struct for save the DAT cmd properties.
+ * @param  type     Pointer for save the MEP type of the data. Can be NULL.
+ * @return -1 if an error occurred. 0 if no more data. 1 if a DAT command was read.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepReadNextDatIterator(tAESYS_MEP_DAT_ITERATOR *iterator, tAESYS_MEP_DAT_CMD *cmd, uint8_t *type);
+
+/** @brief Index a response by code without allocate memory or copy the data.
+ *
+ * Validates the frame as AesysMepParseResponse and fills index with every code in
+ * the response (including the codes not supported by the device, with flag 1),
+ * sorted by code. The data are not copied, the index points to the payload inside
+ * mep_frame. The UoPTB frames are decoded in place with AesysMepDecodeUPTBFrameInPlace
+ * so the frame content is modified.
+ *
+ * The MEP_DAT_GZ responses can't be read in place and fail with ENOTSUP. The caller
+ * must write them first as a MEP_DAT frame with AesysMepInflateResponseTo.
+ *
+ * @param  mep_frame      A complete MEP frame that have a response. Must be as it is received by RX buffer.
+ * @param  mep_frame_size The size of the mep_frame.
+ * @param  mep_frame_type The type of mep_frame. 0: PPTP or 1: UPTB. See AESYS_MEP_FRAME_TYPES enum.
+ * @param  index          Pointer to a valid struct for save the index.
+ * @return -1 on error an errno is set with specified error (same as AesysMepParseResponse). 1 if ok.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepIndexResponse(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_RESPONSE_INDEX *index);
+
+/** @brief Search a code in a response index.
+ *
+ * @param  index The index filled by AesysMepIndexResponse.
+ * @param  code  The MEP code to search.
+ * @return NULL if the code is not in the response or pointer to its entry.
+ */
+AESYS_MEP_API const tAESYS_MEP_INDEX_ENTRY * AESYS_MEP_CONV AesysMepFindIndexEntry(const tAESYS_MEP_RESPONSE_INDEX *index, uint16_t code);
+
+/** @brief Get the value of a code in a response index converted to Host Order Byte.
+ *
+ * The AesysMepGetXXX functions search the code in the index and read the value
+ * directly from the frame. The type of the code (see records in AesysMepGetCodeProperties)
+ * must match the function:
+ *
+ *      AesysMepGetU8:     MEP_UINT8 or MEP_BOOL, 1 byte.
+ *      AesysMepGetI8:     MEP_INT8, 1 byte.
+ *      AesysMepGetU16:    MEP_UINT16, 2 bytes.
+ *      AesysMepGetU32:    MEP_UINT32, 4 bytes.
+ *      AesysMepGetString: MEP_STRING or MEP_USTRING. The string points to the frame
+ *                         and is not NULL terminated, length have its size.
+ *
+ * @param  index The index filled by AesysMepIndexResponse.
+ * @param  code  The MEP code to read.
+ * @param  value Pointer to a valid var for save the value.
+ * @return -1 if an error occurred or the type/size not match. 0 if the code is not in
+ *         the response, is not supported or have an error flag. 1 if value was read.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepGetU8(const tAESYS_MEP_RESPONSE_INDEX *index, uint16_t code, uint8_t *value);
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepGetI8(const tAESYS_MEP_RESPONSE_INDEX *index, uint16_t code, int8_t *value);
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepGetU16(const tAESYS_MEP_RESPONSE_INDEX *index, uint16_t code, uint16_t *value);
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepGetU32(const tAESYS_MEP_RESPONSE_INDEX *index, uint16_t code, uint32_t *value);
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepGetString(const tAESYS_MEP_RESPONSE_INDEX *index, uint16_t code, const char **value, uint16_t *length);
+
+/** @brief Decode the response of AesysMepBuildDiagnosticInfoMsg in a single pass.
+ *
+ * Fills the struct directly from the frame without allocate memory. The response must
+ * start with the MEP_CUSTOM_DIAGNOSTIC_INFO_DATA code or with one of the codes of the
+ * group. The codes not supported by the device, with errors or with a wrong length
+ * are not set as valid. The codes not in the group are ignored. The UoPTB frames are
+ * decoded in place with AesysMepDecodeUPTBFrameInPlace so the frame content is modified.
+ *
+ * The MEP_DAT_GZ responses can't be read in place and fail with ENOTSUP. The caller
+ * must write them first as a MEP_DAT frame with AesysMepInflateResponseTo.
+ *
+ * @param  mep_frame      A complete MEP frame that have a response. Must be as it is received by RX buffer.
+ * @param  mep_frame_size The size of the mep_frame.
+ * @param  mep_frame_type The type of mep_frame. 0: PPTP or 1: UPTB. See AESYS_MEP_FRAME_TYPES enum.
+ * @param  info           Pointer to a valid struct for save the values.
+ * @return -1 on error an errno is set with specified error (same as AesysMepParseResponse)
+ *         or EBADMSG if the response is from another group. 1 if ok.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepDecodeDiagnosticInfo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_DIAGNOSTIC_INFO *info);
+
+/** @brief Decode the response of AesysMepBuildDeviceInfoMsg in a single pass.
+ *
+ * Same as AesysMepDecodeDiagnosticInfo for the MEP_CUSTOM_DEVICE_INFO_DATA group.
+ * The MEP_DAT_GZ responses can't be read in place and fail with ENOTSUP. The caller
+ * must write them first as a MEP_DAT frame with AesysMepInflateResponseTo.
+ *
+ * @param  mep_frame      A complete MEP frame that have a response. Must be as it is received by RX buffer.
+ * @param  mep_frame_size The size of the mep_frame.
+ * @param  mep_frame_type The type of mep_frame. 0: PPTP or 1: UPTB. See AESYS_MEP_FRAME_TYPES enum.
+ * @param  info           Pointer to a valid struct for save the values.
+ * @return -1 on error an errno is set with specified error. 1 if ok.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepDecodeDeviceInfo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_DEVICE_INFO *info);
+
+/** @brief Decode the response of AesysMepBuildTempInfoMsg in a single pass.
+ *
+ * Same as AesysMepDecodeDiagnosticInfo for the MEP_CUSTOM_TEMPERATURE_INFO_DATA group.
+ * Also accepts the response of a single temperature code.
+ * The MEP_DAT_GZ responses can't be read in place and fail with ENOTSUP. The caller
+ * must write them first as a MEP_DAT frame with AesysMepInflateResponseTo.
+ *
+ * @param  mep_frame      A complete MEP frame that have a response. Must be as it is received by RX buffer.
+ * @param  mep_frame_size The size of the mep_frame.
+ * @param  mep_frame_type The type of mep_frame. 0: PPTP or 1: UPTB. See AESYS_MEP_FRAME_TYPES enum.
+ * @param  info           Pointer to a valid struct for save the values.
+ * @return -1 on error an errno is set with specified error. 1 if ok.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepDecodeTempInfo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_SENSORS_INFO *info);
+
+/** @brief Decode the response of AesysMepBuildHumidityInfoMsg in a single pass.
+ *
+ * Same as AesysMepDecodeTempInfo for the MEP_CUSTOM_HUMIDITY_INFO_DATA group.
+ * The MEP_DAT_GZ responses can't be read in place and fail with ENOTSUP. The caller
+ * must write them first as a MEP_DAT frame with AesysMepInflateResponseTo.
+ *
+ * @param  mep_frame      A complete MEP frame that have a response. Must be as it is received by RX buffer.
+ * @param  mep_frame_size The size of the mep_frame.
+ * @param  mep_frame_type The type of mep_frame. 0: PPTP or 1: UPTB. See AESYS_MEP_FRAME_TYPES enum.
+ * @param  info           Pointer to a valid struct for save the values.
+ * @return -1 on error an errno is set with specified error. 1 if ok.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepDecodeHumidityInfo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_SENSORS_INFO *info);
+
+/** @brief Decode the response of AesysMepBuildBrightnessInfoMsg in a single pass.
+ *
+ * Same as AesysMepDecodeTempInfo for the MEP_CUSTOM_BRIGHTNESS_INFO_DATA group.
+ * The MEP_DAT_GZ responses can't be read in place and fail with ENOTSUP. The caller
+ * must write them first as a MEP_DAT frame with AesysMepInflateResponseTo.
+ *
+ * @param  mep_frame      A complete MEP frame that have a response. Must be as it is received by RX buffer.
+ * @param  mep_frame_size The size of the mep_frame.
+ * @param  mep_frame_type The type of mep_frame. 0: PPTP or 1: UPTB. See AESYS_MEP_FRAME_TYPES enum.
+ * @param  info           Pointer to a valid struct for save the values.
+ * @return -1 on error an errno is set with specified error. 1 if ok.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepDecodeBrightnessInfo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_SENSORS_INFO *info);
+
+/** @brief Decode the response of AesysMepBuildEnvBrightnessInfoMsg in a single pass.
+ *
+ * Same as AesysMepDecodeTempInfo for the MEP_CUSTOM_EBRIGHTNESS_INFO_DATA group.
+ * The MEP_DAT_GZ responses can't be read in place and fail with ENOTSUP. The caller
+ * must write them first as a MEP_DAT frame with AesysMepInflateResponseTo.
+ *
+ * @param  mep_frame      A complete MEP frame that have a response. Must be as it is received by RX buffer.
+ * @param  mep_frame_size The size of the mep_frame.
+ * @param  mep_frame_type The type of mep_frame. 0: PPTP or 1: UPTB. See AESYS_MEP_FRAME_TYPES enum.
+ * @param  info           Pointer to a valid struct for save the values.
+ * @return -1 on error an errno is set with specified error. 1 if ok.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepDecodeEnvBrightnessInfo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_SENSORS_INFO *info);
+
+/** @brief Decode the response of AesysMepBuildTrafficLightInfoMsg in a single pass.
+ *
+ * Same as AesysMepDecodeTempInfo for the MEP_CUSTOM_TRAFFIC_INFO_DATA group.
+ * The MEP_DAT_GZ responses can't be read in place and fail with ENOTSUP. The caller
+ * must write them first as a MEP_DAT frame with AesysMepInflateResponseTo.
+ *
+ * @param  mep_frame      A complete MEP frame that have a response. Must be as it is received by RX buffer.
+ * @param  mep_frame_size The size of the mep_frame.
+ * @param  mep_frame_type The type of mep_frame. 0: PPTP or 1: UPTB. See AESYS_MEP_FRAME_TYPES enum.
+ * @param  info           Pointer to a valid struct for save the values.
+ * @return -1 on error an errno is set with specified error. 1 if ok.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepDecodeTrafficLightInfo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, tAESYS_MEP_SENSORS_INFO *info);
+
+/** @brief Parse a UoPTB frame already decoded for get the results of a previous MEP command(s).
+ *
+ * Same as AesysMepParseResponse but the frame is not validated and decoded again. The
+ * frame must have the format returned by AesysMepDecodeUPTBFrame, e.g. the "frame"
+ * member of tAESYS_MEP_UPTB_DEFRAMER after AesysMepReadNextUPTBFrame returns 1.
+ *
+ * @param  decoded A decoded UoPTB frame. Can be casted to (tAESYS_MEP_UPTB_FRAME *).
+ * @return NULL on error an errno is set with specified error or pointer to a tAESYS_MEP_RESPONSE structure.
+ */
+AESYS_MEP_API tAESYS_MEP_RESPONSE * AESYS_MEP_CONV AesysMepParseDecodedUPTBFrame(uint8_t *decoded);
+
 /** @brief Validate and retrieve a VisExt code data from MEP frame.
  *
  * The p_data structure param is a pointer to the payload param. If payload
@@ -1163,6 +1839,44 @@ AESYS_MEP_API tAESYS_MEP_BUFFER * AESYS_MEP_CONV AesysMepBuildTrafficLightInfoMs
  */
 AESYS_MEP_API tAESYS_MEP_BUFFER * AESYS_MEP_CONV AesysMepBuildEnvBrightnessInfoMsg(uint8_t type, uint16_t trans_id, uint16_t code);
 
+/** @brief Build the next MEP message for get a list of codes.
+ *
+ * Packs the GET commands from cmds[*offset] in a single frame, as many as fit in
+ * K_MEP_MAX_DATA_SIZE (and K_MEP_MAX_FRAME_SIZE once escaped in UoPTB frames), and
+ * advances offset to the first command not included. Call it until offset is count
+ * for build all the frames, using a distinct transaction id for each frame:
+ *
+ *      uint16_t i = 0;
+ *      while (i < count && (buffer = AesysMepBuildNextGetMsg(type,tran++,0,cmds,count,&i)) != NULL)
+ *      { ... send and AesysMepFreeBuffer(buffer) ... }
+ *
+ * The code and offset of cmds are in Host Order Byte. The codes supported by this
+ * library must be readable (see AesysMepGetCodeProperties), the other codes are sent
+ * as they are. If sentinel is not 0 then is the first code in every frame, so the
+ * response can be correlated because the "type" member in tAESYS_MEP_RESPONSE will be
+ * the sentinel, i.e. one of the AESYS_MEP_CUSTOM_CODES. The device answer the sentinel
+ * as a code not supported.
+ *
+ * The available types are:
+ *                         - 0: PPTP     frame
+ *                         - 1: UoPTB    frame with STX and ETX bytes
+ *                         - 2: UoPTBNTX frame without STX/ETX bytes
+ *
+ * The return tAESYS_MEP_BUFFER must be freeing by developer using the
+ * function AesysMepFreeBuffer.
+ *
+ * @param  type     The type of tAESYS_MEP_BUFFER to construct.
+ * @param  trans_id The transaction id to use. 0 for not set.
+ * @param  sentinel The code added at start of every frame. 0 for not add.
+ * @param  cmds     The list of codes and offsets to get.
+ * @param  count    The number of elements in cmds.
+ * @param  offset   The first command to pack. Returns the first command not packed.
+ * @return NULL if an error occurred or there aren't more commands (offset >= count). On
+ *         error offset is not modified. Otherwise a pointer to a tAESYS_MEP_BUFFER structure
+ *         allocated dynamically.
+ */
+AESYS_MEP_API tAESYS_MEP_BUFFER * AESYS_MEP_CONV AesysMepBuildNextGetMsg(uint8_t type, uint16_t trans_id, uint16_t sentinel, const tAESYS_MEP_GET_CMD *cmds, uint16_t count, uint16_t *offset);
+
 /**********************************************************************
 *****               Manipulation functions section                *****
 **********************************************************************/
@@ -1236,6 +1950,37 @@ AESYS_MEP_API tAESYS_MEP_BUFFER * AESYS_MEP_CONV AesysMepBuildClearPublication(u
  */
 AESYS_MEP_API tAESYS_MEP_BUFFER * AESYS_MEP_CONV AesysMepBuildDelCode(uint8_t type, uint16_t trans_id, uint16_t code);
 
+/** @brief Build a MEP message for set a list of codes in a single frame.
+ *
+ * Packs all the SET commands in one frame, so the device applies and answers all the
+ * changes in a single transaction, i.e. brightness, traffic light status and last
+ * publication status at the same time. The code, offset and length of cmds are in
+ * Host Order Byte and data is copied as it is (Network Order Byte for numbers).
+ *
+ * Every code must be supported by this library (see AesysMepGetCodeProperties), must
+ * be writable and the length must be the size of its type: 0 for MEP_VOID, 1, 2 or 4
+ * for numbers and booleans, any size for MEP_BINARY and strings. If sentinel is not 0
+ * then is added as first command without data for correlate the response, i.e. one
+ * of the AESYS_MEP_CUSTOM_CODES. Unlike the other builders the values aren't validated.
+ *
+ * The available types are:
+ *                         - 0: PPTP     frame
+ *                         - 1: UoPTB    frame with STX and ETX bytes
+ *                         - 2: UoPTBNTX frame without STX/ETX bytes
+ *
+ * The return tAESYS_MEP_BUFFER must be freeing by developer using the
+ * function AesysMepFreeBuffer.
+ *
+ * @param  type     The type of tAESYS_MEP_BUFFER to construct.
+ * @param  trans_id The transaction id to use. 0 for not set.
+ * @param  sentinel The code added at start of the frame. 0 for not add.
+ * @param  cmds     The list of codes to set.
+ * @param  count    The number of elements in cmds.
+ * @return NULL if an error occurred, some command is not valid or the commands don't fit in
+ *         K_MEP_MAX_DATA_SIZE. Otherwise a pointer to a tAESYS_MEP_BUFFER structure allocated dynamically.
+ */
+AESYS_MEP_API tAESYS_MEP_BUFFER * AESYS_MEP_CONV AesysMepBuildSetMsg(uint8_t type, uint16_t trans_id, uint16_t sentinel, const tAESYS_MEP_SET_CMD *cmds, uint16_t count);
+
 /** @brief Build a MEP message for setting clock.
  *
  * The clock data structure is ymdhms. All elements as integers.
@@ -1517,6 +2262,547 @@ AESYS_MEP_API tAESYS_MEP_BUFFER * AESYS_MEP_CONV AesysMepBuildPictogramMsg(uint8
  * @return NULL if an error occurred or a pointer to a tAESYS_MEP_BUFFER structure allocated dynamically.
  */
 AESYS_MEP_API tAESYS_MEP_BUFFER * AESYS_MEP_CONV AesysMepBuildTextMsg(uint8_t type, uint16_t trans_id, uint8_t size, const tAESYS_MEP_MSG_DATA *msg, const tAESYS_MEP_PANEL_DATA *panel);
+
+/** @brief Build a MEP message for set a publication with text and pictogram pages.
+ *
+ * The pages are sent in a single VisExtensible publication, i.e. a pictogram followed
+ * by a text. Each page have its own duration and params. The text pages are encoded as
+ * AesysMepBuildTextMsg does and the pictogram pages as AesysMepBuildPictogramMsg does.
+ *
+ * Unlike AesysMepBuildTextMsg, a text page without rows or with an invalid type is
+ * treated as error. The panel param is required only if there are text pages.
+ *
+ * The available types are:
+ *                         - 0: PPTP     frame
+ *                         - 1: UoPTB    frame with STX and ETX bytes
+ *                         - 2: UoPTBNTX frame without STX/ETX bytes
+ *
+ * If param type is > 2 or if occurs memory allocation error return NULL.
+ * The return tAESYS_MEP_BUFFER must be freeing by developer using the
+ * function AesysMepFreeBuffer.
+ *
+ * When parse a response with AesysMepParseResponse function, the type memeber in the
+ * returned struct tAESYS_MEP_RESPONSE will have the value SET_PUBLICATION.
+ *
+ * @param  type     The type of tAESYS_MEP_BUFFER to construct.
+ * @param  trans_id The transaction id to use. 0 for not set.
+ * @param  size     The number of pages.
+ * @param  pages    Array of the pages of the publication.
+ * @param  panel    Structure that contains the panel information to use in text pages.
+ * @return NULL if an error occurred or a pointer to a tAESYS_MEP_BUFFER structure allocated dynamically.
+ */
+AESYS_MEP_API tAESYS_MEP_BUFFER * AESYS_MEP_CONV AesysMepBuildPublicationMsg(uint8_t type, uint16_t trans_id, uint8_t size, const tAESYS_MEP_PUB_PAGE *pages, const tAESYS_MEP_PANEL_DATA *panel);
+/**********************************************************************
+*****               Caller buffer functions section               *****
+**********************************************************************/
+
+/** @brief Return the worst case size of a frame with a payload of dlen bytes.
+ *
+ * The UoPTB frames can grow until the double of the size because every
+ * STX, ETX or DLE byte is escaped. The returned size can be used for
+ * assign the buffers used by the AesysMepBuildXXXTo functions, e.g. with
+ * dlen = K_MEP_MAX_DATA_SIZE the size is enough for any message.
+ *
+ * The available types are:
+ *                         - 0: PPTP     frame
+ *                         - 1: UoPTB    frame with STX and ETX bytes
+ *                         - 2: UoPTBNTX frame without STX/ETX bytes
+ *
+ * @param  type The type of frame.
+ * @param  dlen The size of the payload.
+ * @return 0 if type > 2 or dlen > K_MEP_MAX_DATA_SIZE. Otherwise the maximum frame size.
+ */
+AESYS_MEP_API uint16_t AESYS_MEP_CONV AesysMepGetMaxFrameSize(uint8_t type, uint16_t dlen);
+
+/** @brief Same as AesysMepBuildClockInfoMsg but the frame is written in the buffer
+ *         provided by the developer instead of a new tAESYS_MEP_BUFFER.
+ *
+ * All the AesysMepBuildXXXTo functions work in the same way and never allocate memory.
+ * The b_size param is the capacity of buffer. On return b_size have the size of the
+ * frame written, or the exact size required if the buffer is too small. Pass buffer
+ * NULL for only query the required size.
+ *
+ * The other params and validations are the same of the AesysMepBuildXXX function.
+ *
+ * @param  buffer   Buffer for write the frame.
+ * @param  b_size   Capacity of buffer. Returns the frame size or the required size.
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildClockInfoMsgTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildDeviceInfoMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildDeviceInfoMsgTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildDevStatusInfoMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildDevStatusInfoMsgTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildDiagnosticInfoMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildDiagnosticInfoMsgTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildDevRestartedInfoMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildDevRestartedInfoMsgTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildLastPublicationInfoMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildLastPublicationInfoMsgTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildTempInfoMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildTempInfoMsgTo(uint8_t type, uint16_t trans_id, uint16_t code, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildHumidityInfoMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildHumidityInfoMsgTo(uint8_t type, uint16_t trans_id, uint16_t code, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildBrightnessInfoMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildBrightnessInfoMsgTo(uint8_t type, uint16_t trans_id, uint16_t code, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildTrafficLightInfoMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildTrafficLightInfoMsgTo(uint8_t type, uint16_t trans_id, uint16_t code, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildEnvBrightnessInfoMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildEnvBrightnessInfoMsgTo(uint8_t type, uint16_t trans_id, uint16_t code, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildNextGetMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo. The offset
+ *         only is advanced when the frame was written.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildNextGetMsgTo(uint8_t type, uint16_t trans_id, uint16_t sentinel, const tAESYS_MEP_GET_CMD *cmds, uint16_t count, uint16_t *offset, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildClearPublication but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildClearPublicationTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildResetDeviceMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildResetDeviceMsgTo(uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildDelCode but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildDelCodeTo(uint8_t type, uint16_t trans_id, uint16_t code, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildSetMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildSetMsgTo(uint8_t type, uint16_t trans_id, uint16_t sentinel, const tAESYS_MEP_SET_CMD *cmds, uint16_t count, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildClockMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildClockMsgTo(uint8_t type, uint16_t trans_id, uint8_t *clock, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildBrightnessMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildBrightnessMsgTo(uint8_t type, uint16_t trans_id, uint16_t values[], uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildLastPublicationStatusMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildLastPublicationStatusMsgTo(uint8_t type, uint16_t trans_id, uint8_t status, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildDeviceIdMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildDeviceIdMsgTo(uint8_t type, uint16_t trans_id, uint16_t size, const char *strId, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildDeviceDescMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildDeviceDescMsgTo(uint8_t type, uint16_t trans_id, uint16_t size, const char *desc, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildTrafficLightStatusMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildTrafficLightStatusMsgTo(uint8_t type, uint16_t trans_id, uint16_t code, uint16_t value, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildPictogramMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildPictogramMsgTo(uint8_t type, uint16_t trans_id, uint8_t flashing_lamps, uint16_t picto_code, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildTextMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildTextMsgTo(uint8_t type, uint16_t trans_id, uint8_t size, const tAESYS_MEP_MSG_DATA *msg, const tAESYS_MEP_PANEL_DATA *panel, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Same as AesysMepBuildPublicationMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildPublicationMsgTo(uint8_t type, uint16_t trans_id, uint8_t size, const tAESYS_MEP_PUB_PAGE *pages, const tAESYS_MEP_PANEL_DATA *panel, uint8_t *buffer, uint16_t *b_size);
+/**********************************************************************
+*****               Frame template functions section              *****
+**********************************************************************/
+
+/** @brief Create a template from a MEP frame for send it many times.
+ *
+ * The frame is validated and encoded only once, i.e. the frame returned by
+ * AesysMepBuildDevStatusInfoMsg or AesysMepBuildDiagnosticInfoMsg. Then
+ * AesysMepPatchFrameTemplate returns the frame with other transaction id in
+ * constant time: only the transaction id and the CRC are escaped again and the
+ * CRC is updated with the precomputed change of each bit of the transaction id.
+ *
+ * The available types are:
+ *                         - 0: PPTP     frame
+ *                         - 1: UoPTB    frame with STX and ETX bytes
+ *                         - 2: UoPTBNTX frame without STX/ETX bytes
+ *
+ * The return tAESYS_MEP_FRAME_TEMPLATE must be freeing by developer using the
+ * function AesysMepFreeFrameTemplate.
+ *
+ * @param  frame      A complete MEP frame of the type specified.
+ * @param  frame_size The size of the frame.
+ * @param  type       The type of frame.
+ * @param  addr       UoPTB: the logic address to use. The AesysMepBuildXXX functions use 0xFFFE. Not used by PPTP.
+ * @return NULL if an error occurred or the frame is not valid. Otherwise a pointer to a
+ *         tAESYS_MEP_FRAME_TEMPLATE structure allocated dynamically.
+ */
+AESYS_MEP_API tAESYS_MEP_FRAME_TEMPLATE * AESYS_MEP_CONV AesysMepCreateFrameTemplate(const uint8_t *frame, uint16_t frame_size, uint8_t type, uint16_t addr);
+
+/** @brief Get the frame of a template with the transaction id specified.
+ *
+ * The frame is inside the template, so it's valid until the next call with the same
+ * template or until the template is freeing. Don't use the same template from
+ * several threads at the same time.
+ *
+ * @param  tmpl     The template created with AesysMepCreateFrameTemplate.
+ * @param  trans_id The transaction id to use.
+ * @param  size     Returns the size of the frame.
+ * @return NULL if tmpl or size are NULL. Otherwise the frame ready to send.
+ */
+AESYS_MEP_API const uint8_t * AESYS_MEP_CONV AesysMepPatchFrameTemplate(tAESYS_MEP_FRAME_TEMPLATE *tmpl, uint16_t trans_id, uint16_t *size);
+
+/** @brief Create a template of a text publication with variable slots.
+ *
+ * The publication is encoded as AesysMepBuildTextMsg does. Then AesysMepSetTextSlot
+ * replaces the chars of a slot touching only the bytes changed and updating the CRC
+ * incrementally, and AesysMepPatchFrameTemplate(tmpl->frame,...) returns the frame
+ * ready to send with the transaction id specified.
+ *
+ * The initial chars of each slot are taken from the rows of msg. On UoPTB frames
+ * the chars of the slots can't be STX, ETX or DLE bytes.
+ *
+ * The return tAESYS_MEP_TEXT_TEMPLATE must be freeing by developer using the
+ * function AesysMepFreeTextTemplate.
+ *
+ * @param  type    The type of frame to build. See AesysMepBuildTextMsg.
+ * @param  size    The size of the array msg. i.e. the pages.
+ * @param  msg     The pages of the publication. See AesysMepBuildTextMsg.
+ * @param  panel   The panel information. See AesysMepBuildTextMsg.
+ * @param  slots   The variable parts of the publication.
+ * @param  count   The size of the array slots.
+ * @return NULL if an error occurred or a slot is not valid. Otherwise a pointer to a
+ *         tAESYS_MEP_TEXT_TEMPLATE structure allocated dynamically.
+ */
+AESYS_MEP_API tAESYS_MEP_TEXT_TEMPLATE * AESYS_MEP_CONV AesysMepCreateTextTemplate(uint8_t type, uint8_t size, const tAESYS_MEP_MSG_DATA *msg, const tAESYS_MEP_PANEL_DATA *panel, const tAESYS_MEP_TEXT_SLOT *slots, uint8_t count);
+
+/** @brief Replace the chars of a slot of a text template.
+ *
+ * If text is shorter than the slot the rest is filled with spaces.
+ *
+ * @param  tmpl  The template created with AesysMepCreateTextTemplate.
+ * @param  name  The name of the slot.
+ * @param  text  The new chars of the slot.
+ * @param  size  The size of text. Must not exceed the width of the slot.
+ * @return 1 if the slot was updated. 0 if the name is not found. -1 if the
+ *         parameters are invalid or text is too long or has STX, ETX or DLE
+ *         bytes on UoPTB frames.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepSetTextSlot(tAESYS_MEP_TEXT_TEMPLATE *tmpl, const char *name, const uint8_t *text, uint8_t size);
+
+/**********************************************************************
+*****                 Bulk write functions section                *****
+**********************************************************************/
+
+/** @brief Prepare the write of a MEP_BINARY value bigger than a frame.
+ *
+ * The value is split in chunks of chunk_size bytes. Each chunk is a SET command of the
+ * code with the offset of the chunk in the value, i.e. a VisExtensible content or the
+ * MEP_COLORS_CALIBRATION table. The chunks are sent with AesysMepBulkWriteNext while
+ * AesysMepBulkWriteReady returns 1, so up to "window" chunks wait for the response at
+ * the same time instead of wait the response of each frame. The result of each chunk
+ * is reported with AesysMepBulkWriteAck and only the failed chunks are sent again.
+ *
+ * The data is not copied, so it must be valid until the bulk write is freeing.
+ *
+ * The return tAESYS_MEP_BULK_WRITE must be freeing by developer using the
+ * function AesysMepFreeBulkWrite.
+ *
+ * @param  code       The code to write. Must be a writable MEP_BINARY code.
+ * @param  data       The value to write.
+ * @param  size       The size of the value.
+ * @param  chunk_size The bytes of each chunk. 0 for the max size: K_MEP_MAX_DATA_SIZE - 8.
+ * @param  window     The max chunks waiting for the response at the same time.
+ * @return NULL if an error occurred or the parameters are invalid. Otherwise a pointer to a
+ *         tAESYS_MEP_BULK_WRITE structure allocated dynamically.
+ */
+AESYS_MEP_API tAESYS_MEP_BULK_WRITE * AESYS_MEP_CONV AesysMepCreateBulkWrite(uint16_t code, const uint8_t *data, uint32_t size, uint16_t chunk_size, uint16_t window);
+
+/** @brief Check if a chunk can be sent now.
+ *
+ * @param  bulk The bulk write created with AesysMepCreateBulkWrite.
+ * @return 1 if there is a chunk pending to send and the window is not full. Otherwise 0.
+ */
+AESYS_MEP_API uint8_t AESYS_MEP_CONV AesysMepBulkWriteReady(const tAESYS_MEP_BULK_WRITE *bulk);
+
+/** @brief Check if all the chunks were written by the device.
+ *
+ * @param  bulk The bulk write created with AesysMepCreateBulkWrite.
+ * @return 1 if all the chunks were acknowledged. Otherwise 0.
+ */
+AESYS_MEP_API uint8_t AESYS_MEP_CONV AesysMepBulkWriteDone(const tAESYS_MEP_BULK_WRITE *bulk);
+
+/** @brief Build the frame of the next chunk pending to send.
+ *
+ * The failed chunks are sent first, then the chunks never sent in order. The chunk
+ * waits for the response with the transaction id specified, so the transaction id
+ * can't be used by other chunk waiting for the response.
+ *
+ * The available types are:
+ *                         - 0: PPTP     frame
+ *                         - 1: UoPTB    frame with STX and ETX bytes
+ *                         - 2: UoPTBNTX frame without STX/ETX bytes
+ *
+ * The return tAESYS_MEP_BUFFER must be freeing by developer using the
+ * function AesysMepFreeBuffer.
+ *
+ * @param  bulk     The bulk write created with AesysMepCreateBulkWrite.
+ * @param  type     The type of tAESYS_MEP_BUFFER to construct.
+ * @param  trans_id The transaction id to use.
+ * @return NULL if an error occurred, the transaction id is in use or AesysMepBulkWriteReady
+ *         returns 0. Otherwise a pointer to a tAESYS_MEP_BUFFER structure allocated dynamically.
+ */
+AESYS_MEP_API tAESYS_MEP_BUFFER * AESYS_MEP_CONV AesysMepBulkWriteNext(tAESYS_MEP_BULK_WRITE *bulk, uint8_t type, uint16_t trans_id);
+
+/** @brief Same as AesysMepBulkWriteNext but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo. The chunk
+ *         only waits for the response when the frame was written.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBulkWriteNextTo(tAESYS_MEP_BULK_WRITE *bulk, uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Report the result of a chunk sent.
+ *
+ * If success is 1 the chunk is done. Otherwise, i.e. the device returns an error or the
+ * response doesn't arrive in time, the chunk is pending and it will be sent again.
+ *
+ * @param  bulk     The bulk write created with AesysMepCreateBulkWrite.
+ * @param  trans_id The transaction id of the response.
+ * @param  success  1 if the device wrote the chunk. 0 if not.
+ * @return -1 if bulk is NULL. 0 if there is no chunk waiting with that transaction id,
+ *         i.e. a duplicated response. 1 if the chunk was updated.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBulkWriteAck(tAESYS_MEP_BULK_WRITE *bulk, uint16_t trans_id, uint8_t success);
+
+/**********************************************************************
+*****                 Bulk read functions section                 *****
+**********************************************************************/
+
+/** @brief Prepare the read of a value returned by parts.
+ *
+ * When the value doesn't fit in a DAT command the device returns the first part with
+ * the bit K_MEP_DAT_MORE_DATA set in flags, i.e. a long MEP_DEVICE_DESCRIPTION or a
+ * binary code. The first request reads the offset 0 and the size of the part is the
+ * size of the next parts, so each request after the first has a GET command for each
+ * next part (as many as the response can have, up to "gets"). The parts are joined
+ * in the "data" member until the part without the flag is read.
+ *
+ *      while (!AesysMepBulkReadDone(bulk))
+ *      {
+ *          buffer = AesysMepBulkReadNext(bulk,type,tran++);
+ *          ... send, AesysMepFreeBuffer(buffer), receive ...
+ *          if (AesysMepBulkReadFeed(bulk,frame,frame_size,type) == -1)
+ *              break;
+ *      }
+ *
+ * The return tAESYS_MEP_BULK_READ must be freeing by developer using the
+ * function AesysMepFreeBulkRead.
+ *
+ * @param  code     The code to read. Must be readable if it's supported by this library.
+ * @param  gets     The max GET commands in each request.
+ * @param  max_size The max size of the value. A bigger value is an error.
+ * @return NULL if an error occurred or the parameters are invalid. Otherwise a pointer to a
+ *         tAESYS_MEP_BULK_READ structure allocated dynamically.
+ */
+AESYS_MEP_API tAESYS_MEP_BULK_READ * AESYS_MEP_CONV AesysMepCreateBulkRead(uint16_t code, uint16_t gets, uint32_t max_size);
+
+/** @brief Check if the value was read completely.
+ *
+ * @param  bulk The bulk read created with AesysMepCreateBulkRead.
+ * @return 1 if the last part was read. Otherwise 0.
+ */
+AESYS_MEP_API uint8_t AESYS_MEP_CONV AesysMepBulkReadDone(const tAESYS_MEP_BULK_READ *bulk);
+
+/** @brief Build the request of the next parts of the value.
+ *
+ * The request waits for the response with the transaction id specified. If the
+ * response doesn't arrive, call it again for send the request with other id.
+ *
+ * The available types are:
+ *                         - 0: PPTP     frame
+ *                         - 1: UoPTB    frame with STX and ETX bytes
+ *                         - 2: UoPTBNTX frame without STX/ETX bytes
+ *
+ * The return tAESYS_MEP_BUFFER must be freeing by developer using the
+ * function AesysMepFreeBuffer.
+ *
+ * @param  bulk     The bulk read created with AesysMepCreateBulkRead.
+ * @param  type     The type of tAESYS_MEP_BUFFER to construct.
+ * @param  trans_id The transaction id to use.
+ * @return NULL if an error occurred or the value was read. Otherwise a pointer to a
+ *         tAESYS_MEP_BUFFER structure allocated dynamically.
+ */
+AESYS_MEP_API tAESYS_MEP_BUFFER * AESYS_MEP_CONV AesysMepBulkReadNext(tAESYS_MEP_BULK_READ *bulk, uint8_t type, uint16_t trans_id);
+
+/** @brief Same as AesysMepBulkReadNext but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo. The request
+ *         only waits for the response when the frame was written.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBulkReadNextTo(tAESYS_MEP_BULK_READ *bulk, uint8_t type, uint16_t trans_id, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Add the parts of a response to the value.
+ *
+ * Only the parts that continue the value are added, so the parts after a gap (a part
+ * shorter than expected) are requested again by AesysMepBulkReadNext. The UoPTB frames
+ * are decoded in place, see AesysMepInitDatIterator.
+ *
+ * The MEP_DAT_GZ responses can't be read in place and fail with ENOTSUP. The caller
+ * must write them first as a MEP_DAT frame with AesysMepInflateResponseTo.
+ *
+ * @param  bulk           The bulk read created with AesysMepCreateBulkRead.
+ * @param  mep_frame      A complete MEP frame that have a response. Must be as it is received by RX buffer.
+ * @param  mep_frame_size The size of the mep_frame.
+ * @param  mep_frame_type The type of mep_frame. 0: PPTP or 1: UPTB. See AESYS_MEP_FRAME_TYPES enum.
+ * @return -1 on error an errno is set with specified error: the errors of AesysMepParseResponse,
+ *         EIO if the device returns an error reading the code, EFBIG if the value is bigger
+ *         than max_size or ENOMEM. 0 if it's not the response of the request waiting.
+ *         1 if the response was added.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBulkReadFeed(tAESYS_MEP_BULK_READ *bulk, uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type);
+
+#ifdef AESYS_MEP_GZIP
+/**********************************************************************
+*****                    Gzip functions section                   *****
+**********************************************************************/
+
+/** @brief Create the gzip version of a MEP frame.
+ *
+ * The payload of the frame is compressed and the frame is created again with the
+ * same address and transaction id and the gzip version of the command. E.g. a text
+ * publication built with AesysMepBuildTextMsg is sent as MEP_SET_GZ. If the compressed
+ * payload is not smaller, the frame is returned without compress.
+ *
+ * Only available when the library is compiled with AESYS_MEP_GZIP. Requires zlib.
+ *
+ * @param  type           The type of frame. See AESYS_MEP_FRAME_TYPES enum.
+ * @param  mep_frame      A complete MEP frame built by this library.
+ * @param  mep_frame_size The size of the mep_frame.
+ * @return NULL on error or if the frame is already compressed. Otherwise a pointer to a
+ *         tAESYS_MEP_BUFFER structure that must be freed with AesysMepFreeBuffer.
+ */
+AESYS_MEP_API tAESYS_MEP_BUFFER * AESYS_MEP_CONV AesysMepBuildGzipMsg(uint8_t type, uint8_t *mep_frame, uint16_t mep_frame_size);
+
+/** @brief Same as AesysMepBuildGzipMsg but the frame is written in the buffer
+ *         provided by the developer. See AesysMepBuildClockInfoMsgTo.
+ *
+ * @return -1 if an error occurred. 0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepBuildGzipMsgTo(uint8_t type, uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t *buffer, uint16_t *b_size);
+
+/** @brief Write the response of a MEP_DAT_GZ frame as a PPTP MEP_DAT frame.
+ *
+ * The payload is inflated directly in the buffer of the developer, so the response
+ * can be read with AesysMepInitDatIterator, AesysMepIndexResponse, the AesysMepDecodeXXXInfo
+ * functions or any function that takes a PPTP frame without other copy. These functions
+ * fail with ENOTSUP when they receive a MEP_DAT_GZ frame. The MEP_DAT frames are copied without change.
+ * The UoPTB frames are decoded in place so the frame content is modified.
+ *
+ * The b_size param is the capacity of buffer. On return b_size have the size of the
+ * frame written, or the size required if the buffer is too small. Pass buffer NULL for
+ * only query the required size.
+ *
+ * @param  mep_frame      A complete MEP frame that have a response. Must be as it is received by RX buffer.
+ * @param  mep_frame_size The size of the mep_frame.
+ * @param  mep_frame_type The type of mep_frame. 0: PPTP or 1: UPTB. See AESYS_MEP_FRAME_TYPES enum.
+ * @param  buffer         Buffer for write the PPTP frame.
+ * @param  b_size         Capacity of buffer. Returns the frame size or the required size.
+ * @return -1 on error an errno is set with specified error (same as AesysMepParseResponse).
+ *         0 if the buffer is too small. 1 if the frame was written.
+ */
+AESYS_MEP_API char AESYS_MEP_CONV AesysMepInflateResponseTo(uint8_t *mep_frame, uint16_t mep_frame_size, uint8_t mep_frame_type, uint8_t *buffer, uint16_t *b_size);
+#endif
+
 /**********************************************************************
 *****               Free resources functions section              *****
 **********************************************************************/
@@ -1533,6 +2819,46 @@ AESYS_MEP_API tAESYS_MEP_BUFFER * AESYS_MEP_CONV AesysMepBuildTextMsg(uint8_t ty
  */
 AESYS_MEP_API void AESYS_MEP_CONV AesysMepFreeBuffer(tAESYS_MEP_BUFFER *buffer);
 
+/** @brief Free resource used by tAESYS_MEP_FRAME_TEMPLATE structure generated
+ *         when use AesysMepCreateFrameTemplate function.
+ *
+ * If tmpl is NULL then do nothing.
+ *
+ * @param  tmpl Pointer to tAESYS_MEP_FRAME_TEMPLATE structure to free.
+ * @return void
+ */
+AESYS_MEP_API void AESYS_MEP_CONV AesysMepFreeFrameTemplate(tAESYS_MEP_FRAME_TEMPLATE *tmpl);
+
+/** @brief Free resource used by tAESYS_MEP_TEXT_TEMPLATE structure generated
+ *         when use AesysMepCreateTextTemplate function.
+ *
+ * If tmpl is NULL then do nothing.
+ *
+ * @param  tmpl Pointer to tAESYS_MEP_TEXT_TEMPLATE structure to free.
+ * @return void
+ */
+AESYS_MEP_API void AESYS_MEP_CONV AesysMepFreeTextTemplate(tAESYS_MEP_TEXT_TEMPLATE *tmpl);
+
+/** @brief Free resource used by tAESYS_MEP_BULK_WRITE structure generated
+ *         when use AesysMepCreateBulkWrite function.
+ *
+ * If bulk is NULL then do nothing. The data written is not freeing.
+ *
+ * @param  bulk Pointer to tAESYS_MEP_BULK_WRITE structure to free.
+ * @return void
+ */
+AESYS_MEP_API void AESYS_MEP_CONV AesysMepFreeBulkWrite(tAESYS_MEP_BULK_WRITE *bulk);
+
+/** @brief Free resource used by tAESYS_MEP_BULK_READ structure generated
+ *         when use AesysMepCreateBulkRead function, including the value read.
+ *
+ * If bulk is NULL then do nothing.
+ *
+ * @param  bulk Pointer to tAESYS_MEP_BULK_READ structure to free.
+ * @return void
+ */
+AESYS_MEP_API void AESYS_MEP_CONV AesysMepFreeBulkRead(tAESYS_MEP_BULK_READ *bulk);
+
 /** @brief Free resource used by tAESYS_MEP_RESPONSE structure generated
  *         when use AesysMepParseResponse function.
  *